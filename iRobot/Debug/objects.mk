@@ -4,5 +4,5 @@
 
 USER_OBJS :=
 
-LIBS := -ljson_linux-gcc-4.6_libmt
+LIBS := -ljson_linux-gcc-4.6_libmt -lpthread
 
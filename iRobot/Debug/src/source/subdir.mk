@@ -5,17 +5,56 @@
 # Add inputs and outputs from these tool invocations to the build variables 
 CPP_SRCS += \
 ../src/source/AStar.cpp \
+../src/source/Benchmark.cpp \
+../src/source/CooperativePlanner.cpp \
+../src/source/FringeSearch.cpp \
 ../src/source/GameMap.cpp \
+../src/source/GoalBounds.cpp \
+../src/source/GridKernels.cpp \
+../src/source/MapGenerator.cpp \
+../src/source/MemProfile.cpp \
+../src/source/PathCache.cpp \
+../src/source/PathWriter.cpp \
+../src/source/SearchArena.cpp \
+../src/source/SearchScheduler.cpp \
+../src/source/SubgoalGraph.cpp \
+../src/source/VersionedMap.cpp \
 ../src/source/iRobot.cpp 
 
 OBJS += \
 ./src/source/AStar.o \
+./src/source/Benchmark.o \
+./src/source/CooperativePlanner.o \
+./src/source/FringeSearch.o \
 ./src/source/GameMap.o \
+./src/source/GoalBounds.o \
+./src/source/GridKernels.o \
+./src/source/MapGenerator.o \
+./src/source/MemProfile.o \
+./src/source/PathCache.o \
+./src/source/PathWriter.o \
+./src/source/SearchArena.o \
+./src/source/SearchScheduler.o \
+./src/source/SubgoalGraph.o \
+./src/source/VersionedMap.o \
 ./src/source/iRobot.o 
 
 CPP_DEPS += \
 ./src/source/AStar.d \
+./src/source/Benchmark.d \
+./src/source/CooperativePlanner.d \
+./src/source/FringeSearch.d \
 ./src/source/GameMap.d \
+./src/source/GoalBounds.d \
+./src/source/GridKernels.d \
+./src/source/MapGenerator.d \
+./src/source/MemProfile.d \
+./src/source/PathCache.d \
+./src/source/PathWriter.d \
+./src/source/SearchArena.d \
+./src/source/SearchScheduler.d \
+./src/source/SubgoalGraph.d \
+./src/source/VersionedMap.d \
 ./src/source/iRobot.d 
 
 
@@ -23,7 +62,7 @@ CPP_DEPS += \
 src/source/%.o: ../src/source/%.cpp
 	@echo 'Building file: $<'
 	@echo 'Invoking: GCC C++ Compiler'
-	g++ -O0 -g3 -Wall -c -fmessage-length=0 -MMD -MP -MF"$(@:%.o=%.d)" -MT"$(@:%.o=%.d)" -o "$@" "$<"
+	g++ -std=c++17 -pthread -O0 -g3 -Wall -c -fmessage-length=0 -MMD -MP -MF"$(@:%.o=%.d)" -MT"$(@:%.o=%.d)" -o "$@" "$<"
 	@echo 'Finished building: $<'
 	@echo ' '
 
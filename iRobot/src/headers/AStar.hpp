@@ -12,26 +12,25 @@
 
 #include "../headers/Includes.h"
 #include "../headers/GameMap.hpp"
+#include "../headers/GridKernels.hpp"
+#include "../headers/GoalBounds.hpp"
 
-#define FG_UNINIT	(-1.0f)
+#include <memory_resource>
 
-using namespace std;
+#define FG_UNINIT	(-1.0f)
 
-// Tile definition for the A* map
-struct NodeInfo
-{
-	PosTile parent;	// The tile which offers the shortest path to the start point
-	float F,		// Total estimated value of the tile (G+H) (lower is better)
-	      G,		// Total effort needed to reach this tile
-	      H;		// Heuristic guess at the remaining distance to the end point
+// Number of expansions between clock checks in AStar::advanceUntil()
+#define DEADLINE_CHECK_STEPS	64
 
-};
+using namespace std;
 
-// Entry data for Open list. Contains F score for fast sorting
+// Entry data for Open list. Contains F score for fast sorting, and the
+// tie-break key deciding between equal F scores (see TieBreak)
 struct OpenListNode
 {
 	PosTile position;
 	float F;
+	uint32_t tie;	// Lower first; compared as one key with F's bits and the tile (see OpenSorter)
 };
 
 // Possible movement directions for the pathfinding agent
@@ -51,12 +50,65 @@ namespace MoveDir
 	} ;
 }
 
+// Progress state of a (resumable) A* search
+namespace SearchStatus
+{
+	enum Type
+	{
+		SEARCH_RUNNING,		// Still expanding nodes, call advance() again
+		SEARCH_FOUND,		// Path to the end point has been found
+		SEARCH_UNREACHABLE,	// Open list exhausted, no path to the end point
+		SEARCH_CANCELLED,	// Search abandoned by the caller
+		SEARCH_MEMORY_LIMIT,	// Stopped at its memory cap (FringeSearch)
+		NUM_STATUSES // DO NOT ADD BELOW THIS
+	} ;
+}
+
+// Ordering of Open list nodes with equal F scores
+namespace TieBreak
+{
+	enum Type
+	{
+		TIE_NONE,		// F only: equal F scores come out in whatever order sort() leaves them
+		TIE_LOW_H,		// Lower H first (closer to the end point), then lower tile index
+		TIE_HIGH_G,		// Higher G first (further from the start point), then lower tile index
+		TIE_INDEX,		// Lower tile index first (no preference, just a total order)
+		NUM_TIE_BREAKS // DO NOT ADD BELOW THIS
+	} ;
+}
+
+// Open list sort key: F's bits, the tie key, then the tile's row and column (row-major tile
+// index order). F, G and H are never negative, so their bits order like they do
+// The four 32-bit fields don't fit in 64 bits, so the key is a 128-bit integer (GCC/Clang)
+__extension__ typedef unsigned __int128 OpenKey;
+
 // Sorting priority definition for Open list
 // Use with sort(vector.begin(), vector.end(), open_sorter)
+// Apart from TieBreak::TIE_NONE the order is total (no two nodes share a tile), so it
+// doesn't depend on the sort algorithm: every build expands the same tiles
 struct OpenSorter
 {
+	TieBreak::Type tie_break;
+
+	static uint32_t floatBits(float value)
+	{
+		uint32_t bits;
+		memcpy(&bits, &value, sizeof(bits));
+		return bits;
+	}
+
+	static OpenKey getKey(const OpenListNode &node)
+	{
+		return ((OpenKey)floatBits(node.F) << 96) | ((OpenKey)node.tie << 64) |
+		       ((OpenKey)node.position.y << 32) | node.position.x;
+	}
+
 	bool operator ()(const OpenListNode &a, const OpenListNode &b ) {
-		return a.F < b.F;	// Sort by smallest-first
+		if(tie_break == TieBreak::TIE_NONE)
+			return a.F < b.F;	// Sort by smallest-first
+
+		// F, the tie key and the tile in one compare
+		return getKey(a) < getKey(b);
 	}
 };
 
@@ -79,20 +131,43 @@ public:
 	AStar();
 
 	/**
-	 * Function: AStar(const GameMap &game_map, const PosTile &start_pos_arg, const PosTile &end_pos_arg)
+	 * Function: AStar(const GameMap &game_map, const PosTile &start_pos_arg, const PosTile &end_pos_arg, float robot_radius_arg, pmr::memory_resource *memory_arg)
 	 * Use: Initializes A* data map from GameMap traversability map and start/end positions
-	 *      Creates 2D matrix of NodeInfos the same width/height as game_map
-	 *      Initializes all of the F/G/H values
-	 *
+	 *      Creates the parent/F/G/H planes the same width/height as game_map
+	 *      Initializes all of the F/G/H values (with the vectorised GridKernels)
+	 *      Keeps a pointer to game_map for advance()/advanceUntil(), so game_map must
+	 *      outlive the search
 	 * @param game_map The traversability map (must be initialized prior to passing to A*)
 	 * @param start_pos_arg The start [x,y] tile for the A* agent
 	 * @param end_pos_arg The end [x,y] tile for the A* agent
+	 * @param robot_radius_arg The robot radius (in tiles), tiles with less clearance are blocked
+	 *                         (0 for a single-point robot)
+	 * @param memory_arg Where the planes and Open list are allocated (e.g. a SearchArena, which
+	 *                   must outlive the search). Defaults to the heap
 	 */
-	AStar(const GameMap &game_map, const PosTile &start_pos_arg, const PosTile &end_pos_arg);
+	AStar(const GameMap &game_map, const PosTile &start_pos_arg, const PosTile &end_pos_arg,
+	      float robot_radius_arg = 0.0f, pmr::memory_resource *memory_arg = pmr::get_default_resource());
+
+	/**
+	 * Function: AStar(const shared_ptr<const GameMap> &map_snapshot_arg, const PosTile &start_pos_arg, const PosTile &end_pos_arg, float robot_radius_arg, pmr::memory_resource *memory_arg)
+	 * Use: Same as above, on a map snapshot (see VersionedMap::acquire())
+	 *      The search holds the snapshot, so it keeps reading the same map version for
+	 *      its whole life, whatever versions are published meanwhile
+	 *
+	 * @param map_snapshot_arg The map snapshot
+	 * @param start_pos_arg The start [x,y] tile for the A* agent
+	 * @param end_pos_arg The end [x,y] tile for the A* agent
+	 * @param robot_radius_arg The robot radius (in tiles)
+	 * @param memory_arg Where the planes and Open list are allocated
+	 */
+	AStar(const shared_ptr<const GameMap> &map_snapshot_arg, const PosTile &start_pos_arg,
+	      const PosTile &end_pos_arg, float robot_radius_arg = 0.0f,
+	      pmr::memory_resource *memory_arg = pmr::get_default_resource());
 
 	/**
 	 * Function: ~GameMap()
 	 * Use: Destructor
+	 *      Records the Open list high-water mark (if MEM_PROFILE)
 	 *
 	 * @param void
 	 */
@@ -111,6 +186,103 @@ public:
 	 */
 	void runStep(const GameMap &game_map, bool &blocked, bool &done);
 
+	//---------------------------------------------------------------------
+	// Resumable search functions
+	//---------------------------------------------------------------------
+	/**
+	 * Function: advance()
+	 * Use: Run up to 'max_expansions' steps of the A* algorithm, then return control
+	 *      Returns immediately if the search is no longer running
+	 *
+	 * @param max_expansions The maximum number of nodes to expand in this call
+	 * @return SearchStatus::Type The status of the search after this call
+	 */
+	SearchStatus::Type advance(unsigned long max_expansions);
+
+	/**
+	 * Function: advanceUntil()
+	 * Use: Run steps of the A* algorithm until the search finishes or 'deadline' passes
+	 *      The clock is only sampled every DEADLINE_CHECK_STEPS expansions, so the
+	 *      deadline may be overrun by that many expansions
+	 *
+	 * @param deadline The (steady clock) time at which to return control
+	 * @return SearchStatus::Type The status of the search after this call
+	 */
+	SearchStatus::Type advanceUntil(const chrono::steady_clock::time_point &deadline);
+
+	/**
+	 * Function: printProgress()
+	 * Use: Print the iteration number, Open list size and the F/G/H of the front tile
+	 *      (main() calls it between batches, so a long search doesn't look stalled)
+	 *
+	 * @param void
+	 * @return void
+	 */
+	void printProgress() const;
+
+	/**
+	 * Function: cancel()
+	 * Use: Abandon the search. Later advance() calls do nothing
+	 *      Has no effect on a search that has already finished
+	 *
+	 * @param void
+	 * @return void
+	 */
+	void cancel();
+
+	/**
+	 * Function: setGoalBounds()
+	 * Use: Skip moves that can't start a shortest path to the end point (see GoalBounds)
+	 *      Ignored unless the bounds are ready, built for a map of this size, and the robot
+	 *      radius is 0. The bounds must have been built from this search's map, and outlive it
+	 *
+	 * @param goal_bounds_arg The goal bounds (NULL to stop using them)
+	 * @return bool 'true' if the bounds will be used
+	 */
+	bool setGoalBounds(const GoalBounds *goal_bounds_arg);
+
+	/**
+	 * Function: setTieBreak()
+	 * Use: Choose how nodes with equal F scores are ordered (default ASTAR_TIE_BREAK)
+	 *      Call before the first advance()
+	 *
+	 * @param tie_break_arg The tie-break order
+	 * @return void
+	 */
+	void setTieBreak(TieBreak::Type tie_break_arg) { open_sort.tie_break = tie_break_arg; }
+
+	/**
+	 * Function: setOpenHeap()
+	 * Use: With a tie-break order (total), keep the Open list as a binary heap (the default)
+	 *      or sort it every step like TieBreak::TIE_NONE does. Both expand the same tiles;
+	 *      sorting is only there to measure what the heap saves (see 'bench ties')
+	 *      Call before the first advance()
+	 *
+	 * @param open_heap_arg 'true' for a heap, 'false' to sort
+	 * @return void
+	 */
+	void setOpenHeap(bool open_heap_arg) { open_heap = open_heap_arg; }
+
+	/**
+	 * Function: setOctileHeuristic()
+	 * Use: Choose the heuristic (default ASTAR_HEURISTIC_OCTILE): octile distance, which never
+	 *      overestimates, or Manhattan distance. Recomputes the H values and the start node
+	 *      Call before the first advance()
+	 *
+	 * @param octile_arg 'true' for octile distance, 'false' for Manhattan distance
+	 * @return void
+	 */
+	void setOctileHeuristic(bool octile_arg);
+	/**
+	 * Function: getPath()
+	 * Use: Compile the tile positions from the start point to the end point
+	 *      If the path has not been found (yet), compiles the path to the best node so far
+	 *
+	 * @param path The return path (used referenced variable for efficiency)
+	 * @return void
+	 */
+	void getPath(vector<PosTile> &path) const;
+
 	/**
 	 * Function: getPathString()
 	 * Use: Compile a stringstream of all tile positions from start to end poinst
@@ -131,7 +303,7 @@ public:
 	 * @param pos The tile position
 	 * @return float The F value
 	 */
-	float getF(PosTile pos) const { return the_map[pos.y][pos.x].F; }
+	float getF(PosTile pos) const { return f_vals[pos.y*map_width + pos.x]; }
 	/**
 	 * Function: getG()
 	 * Use: Fetch G score from a specific tile
@@ -139,7 +311,7 @@ public:
 	 * @param pos The tile position
 	 * @return float The G value
 	 */
-	float getG(PosTile pos) const { return the_map[pos.y][pos.x].G; }
+	float getG(PosTile pos) const { return g_vals[pos.y*map_width + pos.x]; }
 	/**
 	 * Function: getH()
 	 * Use: Fetch H score from a specific tile
@@ -147,34 +319,89 @@ public:
 	 * @param pos The tile position
 	 * @return float The H value
 	 */
-	float getH(PosTile pos) const { return the_map[pos.y][pos.x].H; }
+	float getH(PosTile pos) const { return h_vals[pos.y*map_width + pos.x]; }
+	/**
+	 * Function: getStatus()
+	 *
+	 * @param void
+	 * @return SearchStatus::Type The current status of the search
+	 */
+	SearchStatus::Type getStatus() const { return status; }
+	/**
+	 * Function: getBestPos()
+	 * Use: Fetch the expanded tile closest (lowest H) to the end point so far
+	 *      Useful as a partial result while the search is still running
+	 *
+	 * @param void
+	 * @return PosTile The best tile so far
+	 */
+	PosTile getBestPos() const { return best_pos; }
+	/**
+	 * Function: getIterationNum()
+	 *
+	 * @param void
+	 * @return unsigned long Number of nodes expanded so far
+	 */
+	unsigned long getIterationNum() const { return iteration_num; }
+	/**
+	 * Function: getMaxOpenSize()
+	 *
+	 * @param void
+	 * @return size_t Largest size the Open list has reached so far
+	 */
+	size_t getMaxOpenSize() const { return max_open_size; }
 
 
 
 private:
 
-	// The map (a NodeInfo vector matrix showing whether each tile is/isn't traversable)
-	std::vector< std::vector<NodeInfo> > the_map;
+	// The map, as one row-major plane per tile value (structure of arrays), so the
+	// full-grid initialisation passes run as contiguous vector stores
+	pmr::vector<PosTile> parents;	// The tile which offers the shortest path to the start point
+	pmr::vector<float> f_vals,		// Total estimated value of the tile (G+H) (lower is better)
+	                   g_vals,		// Total effort needed to reach this tile
+	                   h_vals;		// Heuristic guess at the remaining distance to the end point
 
 	// Map width/height
 	unsigned int map_width, map_height;
 
+	// The traversability map used by advance()/advanceUntil()
+	// (and the snapshot holding it alive, if the search was started on one)
+	const GameMap *game_map_ptr;
+	shared_ptr<const GameMap> map_snapshot;
+
+	// Current status of the search, and the expanded tile closest to the end point
+	SearchStatus::Type status;
+	PosTile best_pos;
+
 	// The start and end points
 	PosTile start_pos, end_pos;
 
+	// The robot radius (see GameMap::isPassable())
+	float robot_radius;
+
+	// Goal bounds pruning the moves (NULL if not used, see setGoalBounds())
+	const GoalBounds *goal_bounds;
+
 	// A* iteration number
 	unsigned long iteration_num;
 
-	// The Open/Closed lists
-	deque<OpenListNode> open_list;
-	vector<PosTile> closed_list;
+	// The Open list, and the largest size it has reached
+	// (there's no Closed list: a tile with a G value has been reached, see runStep())
+	pmr::deque<OpenListNode> open_list;
+	size_t max_open_size;
 
-	// The sorter for the Open list
+	// The sorter for the Open list, and whether a total order keeps it as a heap
 	OpenSorter open_sort;
+	bool open_heap;
+
+	// Whether H is the octile distance (else the Manhattan distance)
+	bool octile_heuristic;
 
 	/**
 	 * Function: calcHVals()
-	 * Use: Calculates the (H)euristic values for all tiles
+	 * Use: Calculates the (H)euristic values for all tiles, one row at a time
+	 *      Manhattan distance, or octile distance if(octile_heuristic)
 	 *
 	 * @param void
 	 * @return void
@@ -200,22 +427,30 @@ private:
 	void initOpenList();
 
 	/**
-	 * Function: findInOpenList()
-	 * Use: Search the Open list for specific position and F value
+	 * Function: calcTieKey()
 	 *
-	 * @param search_node The node to find in the Open list
-	 * @return int the index of object found in list (-1 if not found)
+	 * @param tile_idx The tile index (y*map_width + x)
+	 * @return uint32_t The tile's tie-break key (lower first; see TieBreak): the bits of H,
+	 *                  or the bits of G inverted (G and H are never negative, so the bits order like them),
+	 *                  or 0 (the tile decides)
 	 */
-	int findInOpenList(OpenListNode &search_node);
+	uint32_t calcTieKey(size_t tile_idx) const
+	{
+		if(open_sort.tie_break == TieBreak::TIE_LOW_H)
+			return OpenSorter::floatBits(h_vals[tile_idx]);
+		if(open_sort.tie_break == TieBreak::TIE_HIGH_G)
+			return ~OpenSorter::floatBits(g_vals[tile_idx]);
+		return 0;
+	}
 
 	/**
-	 * Function: findInClosedList()
-	 * Use: Search the Closed list for specific position
+	 * Function: findInOpenList()
+	 * Use: Search the Open list for specific position and F value
 	 *
-	 * @param search_node The node to find in the Closed list
+	 * @param search_node The node to find in the Open list
 	 * @return int the index of object found in list (-1 if not found)
 	 */
-	int findInClosedList(PosTile &search_tile);
+	int findInOpenList(OpenListNode &search_node);
 
 	/**
 	 * Function: printMap()
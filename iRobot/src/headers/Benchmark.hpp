@@ -0,0 +1,189 @@
+/**
+ * Benchmark.hpp
+ *  Created on: Oct 18, 2026
+ *      Author: iRobot maintainers
+ *     Purpose: Command line benchmarks ('iRobot bench <name> ...')
+ *              See README.txt for the list of benchmarks and their arguments
+ */
+
+#ifndef BENCHMARK_HPP_
+#define BENCHMARK_HPP_
+
+#include "../headers/Includes.h"
+#include "../headers/GameMap.hpp"
+
+using namespace std;
+
+/**
+ * Function: runBenchmark()
+ * Use: Benchmark mode: iRobot bench <name> [arguments...]
+ *      Prints usage if the benchmark name is unknown
+ *
+ * @param argc Number of command line arguments
+ * @param argv The command line arguments (argv[1] == "bench")
+ * @return 0 benchmark ran
+ *         1 bad arguments or failed to load a map
+ */
+int runBenchmark(int argc, char *argv[]);
+
+/**
+ * Function: benchCooperative()
+ * Use: Plans 'num_robots' robots with random (seeded) distinct starts and goals using the
+ *      cooperative planner, and reports robots planned per second and any collisions
+ *
+ * @param game_map The traversability map
+ * @param num_robots The number of robots
+ * @param window The planner window (time steps)
+ * @param seed The seed for picking starts and goals
+ * @return void
+ */
+void benchCooperative(const GameMap &game_map, unsigned int num_robots, unsigned int window,
+                      unsigned long long seed);
+
+/**
+ * Function: benchSubgoal()
+ * Use: Preprocesses a map into a subgoal graph, saves and reloads it, then times
+ *      'num_queries' random (seeded) queries. Optionally checks the first queries against AStar
+ *      (reachability, and how much longer the subgoal paths are, since they can't cut corners)
+ *
+ * @param game_map The traversability map
+ * @param map_file_name The map file (the graph is saved next to it)
+ * @param num_queries The number of queries
+ * @param num_checks The number of queries to repeat with AStar
+ * @return void
+ */
+void benchSubgoal(const GameMap &game_map, const string &map_file_name, unsigned int num_queries,
+                  unsigned int num_checks);
+
+/**
+ * Function: benchSnapshots()
+ * Use: Runs random (seeded) AStar searches on map snapshots in several threads while
+ *      another thread keeps publishing obstacle updates (a random block added, then removed)
+ *      Checks every path against its own snapshot, and that old versions are freed afterwards
+ *
+ * @param game_map The traversability map
+ * @param num_searches The number of searches
+ * @param block_size The side of the obstacle blocks (tiles)
+ * @return void
+ */
+void benchSnapshots(const GameMap &game_map, unsigned int num_searches, unsigned int block_size);
+
+/**
+ * Function: benchKernels()
+ * Use: Times the full-grid passes (G/F fills, heuristic rows, counting and scanning
+ *      traversability words, AStar setup) on a random map at every kernel level the
+ *      CPU supports, and checks that every level gets the same results
+ *
+ * @param width The map width
+ * @param height The map height
+ * @param reps The number of runs of each pass (the best is reported)
+ * @return void
+ */
+void benchKernels(unsigned int width, unsigned int height, unsigned int reps);
+
+/**
+ * Function: benchAlloc()
+ * Use: Runs the same random (seeded) AStar queries with the planes and Open list on the
+ *      heap, then in one SearchArena reset between queries, and compares the time and
+ *      (if MEM_PROFILE) the heap allocations per query
+ *
+ * @param game_map The traversability map
+ * @param num_queries The number of queries
+ * @return void
+ */
+void benchAlloc(const GameMap &game_map, unsigned int num_queries);
+
+/**
+ * Function: benchScheduler()
+ * Use: Runs random (seeded) AStar queries standalone, then all at once through a
+ *      SearchScheduler (by runSlice(), then by runUntil() with 1 ms ticks), and checks
+ *      every interleaved search ends with the same status and path as its standalone run
+ *
+ * @param game_map The traversability map
+ * @param num_searches The number of searches
+ * @param quantum The scheduler's expansions per search per turn
+ * @return void
+ */
+void benchScheduler(const GameMap &game_map, unsigned int num_searches, unsigned long quantum);
+
+/**
+ * Function: benchCache()
+ * Use: Looks up random (seeded) queries of a fixed set through a PathCache, adding a
+ *      random obstacle block (or clearing it again) every 'update_every' lookups, and
+ *      reports the hit rate, hit and miss latency, onObstacleUpdate() time, and any hit
+ *      whose path the current map blocks
+ *
+ * @param game_map The traversability map (updated by the benchmark)
+ * @param num_lookups The number of lookups
+ * @param num_queries The number of distinct queries
+ * @param update_every Lookups between obstacle updates (0 for none)
+ * @param max_bytes The cache's memory bound
+ * @return void
+ */
+void benchCache(GameMap &game_map, unsigned int num_lookups, unsigned int num_queries, unsigned int update_every,
+                size_t max_bytes);
+
+/**
+ * Function: benchFringe()
+ * Use: Runs each map file's own query with AStar and with FringeSearch, and compares
+ *      their peak search memory (AStar's measured in a SearchArena), time, expansions and
+ *      path cost. Files that don't load are reported and skipped
+ *
+ * @param map_files The map files
+ * @param max_bytes The FringeSearch memory cap
+ * @return void
+ */
+void benchFringe(const vector<string> &map_files, size_t max_bytes);
+
+/**
+ * Function: benchLoad()
+ * Use: Times loading (read, parse and build) each map file, best of 'reps' loads, and
+ *      checks every file gives the same map as the first (e.g. a map's tile, run and
+ *      binary files). Files that don't load are reported and skipped
+ *
+ * @param map_files The map files
+ * @param reps The number of loads of each file
+ * @return void
+ */
+void benchLoad(const vector<string> &map_files, unsigned int reps);
+
+/**
+ * Function: benchGoalBounds()
+ * Use: Loads the map's goal bounds side file, or builds and saves them (timed), then runs
+ *      the same random (seeded) AStar queries with Manhattan and octile H without the bounds,
+ *      and octile H with them. Compares expansions, time and path cost (the bounded costs
+ *      must equal octile AStar's), and weighs a build against the time saved per query
+ *
+ * @param game_map The traversability map
+ * @param map_file_name The map file (names the side file)
+ * @param num_queries The number of queries
+ * @return void
+ */
+void benchGoalBounds(const GameMap &game_map, const string &map_file_name, unsigned int num_queries);
+
+/**
+ * Function: benchTieBreak()
+ * Use: Runs each map file's own query with AStar in every tie-break order (the tile-index
+ *      order both sorted and as a heap, to separate the heap's effect from the order's), and
+ *      compares expansions, largest Open list, time and path cost. Each order runs twice, the second
+ *      time on another thread, and the two paths are compared tile by tile
+ *      Files that don't load are reported and skipped
+ *
+ * @param map_files The map files
+ * @return void
+ */
+void benchTieBreak(const vector<string> &map_files);
+
+/**
+ * Function: benchClearance()
+ * Use: Checks the clearance of every tile of a random map against brute force (the nearest
+ *      obstacle of every row, in exact integers); wide maps show any loss of precision
+ *
+ * @param width The map width
+ * @param height The map height
+ * @param density Fraction of tiles blocked
+ * @return bool 'true' if no tile is off by more than CLEARANCE_BENCH_TOLERANCE
+ */
+bool benchClearance(unsigned int width, unsigned int height, double density);
+
+#endif /* BENCHMARK_HPP_ */
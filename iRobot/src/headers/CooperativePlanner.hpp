@@ -0,0 +1,403 @@
+/**
+ * CooperativePlanner.hpp
+ *  Created on: Oct 18, 2026
+ *      Author: iRobot maintainers
+ *     Purpose: Multi-robot cooperative pathfinding (Windowed Hierarchical Cooperative A*)
+ *              Robots are planned one at a time in (x,y,t) space, and each plan claims its
+ *              tile-time slots in a shared reservation table so later robots route around it
+ *              Each robot's heuristic is its true reverse distance to the goal, computed on
+ *              demand by a Reverse Resumable A* search (see ReverseDistance)
+ */
+
+#ifndef COOPERATIVEPLANNER_HPP_
+#define COOPERATIVEPLANNER_HPP_
+
+#include "../headers/Includes.h"
+#include "../headers/GameMap.hpp"
+
+#include <cstdint>
+#include <queue>
+
+// Key value for empty SlotTable slots
+#define SLOT_EMPTY_KEY	(~(uint64_t)0)
+
+// Owner value for free reservation slots
+#define NO_ROBOT	0xFFFFFFFFu
+
+// Distance value for tiles that cannot reach the goal
+#define DIST_UNREACHABLE	0xFFFFFFFFu
+
+// Region label for obstacle tiles
+#define NO_COMPONENT	0xFFFFFFFFu
+
+// Marks a final (closed) distance in ReverseDistance
+#define CLOSED_FLAG	0x80000000u
+
+using namespace std;
+
+// Compact open-addressing hash table of 64-bit keys -> 32-bit values
+// Used for the reservation table and for the reverse distances (far less memory and
+// allocation than unordered_map, which matters with hundreds of robots)
+class SlotTable
+{
+public:
+	/**
+	 * Function: SlotTable()
+	 * Use: Creates an empty table
+	 *
+	 * @param void
+	 */
+	SlotTable();
+
+	/**
+	 * Function: find()
+	 *
+	 * @param key The key (must not be SLOT_EMPTY_KEY)
+	 * @return uint32_t* The value stored for 'key' (NULL if not present)
+	 */
+	uint32_t *find(uint64_t key)
+	{
+		size_t slot = findSlot(key);
+		return (keys[slot] == SLOT_EMPTY_KEY) ? NULL : &values[slot];
+	}
+	const uint32_t *find(uint64_t key) const
+	{
+		size_t slot = findSlot(key);
+		return (keys[slot] == SLOT_EMPTY_KEY) ? NULL : &values[slot];
+	}
+
+	/**
+	 * Function: insert()
+	 * Use: Fetch the value for 'key', adding it with 'init_value' if not present
+	 *      The reference is only valid until the next insert()
+	 *
+	 * @param key The key (must not be SLOT_EMPTY_KEY)
+	 * @param init_value The value for a new key
+	 * @return uint32_t& The stored value
+	 */
+	uint32_t &insert(uint64_t key, uint32_t init_value);
+
+	/**
+	 * Function: clear()
+	 * Use: Remove every key (keeps the allocation)
+	 *
+	 * @param void
+	 * @return void
+	 */
+	void clear();
+
+	/**
+	 * Function: getSize()
+	 *
+	 * @param void
+	 * @return size_t Number of keys stored
+	 */
+	size_t getSize() const { return num_slots; }
+
+private:
+
+	// Parallel key/value arrays, capacity is a power of two
+	vector<uint64_t> keys;
+	vector<uint32_t> values;
+	size_t num_slots;
+
+	/**
+	 * Function: findSlot()
+	 *
+	 * @param key The key
+	 * @return size_t The index holding 'key', or the empty index where it would go
+	 */
+	size_t findSlot(uint64_t key) const
+	{
+		size_t mask = keys.size() - 1;
+		size_t slot = (size_t)((key * 0x9E3779B97F4A7C15ULL) >> 20) & mask;
+		while(keys[slot] != SLOT_EMPTY_KEY && keys[slot] != key)
+			slot = (slot + 1) & mask;
+		return slot;
+	}
+
+	/**
+	 * Function: grow()
+	 * Use: Double the capacity and rehash
+	 *
+	 * @param void
+	 * @return void
+	 */
+	void grow();
+};
+
+// Claimed (x, y, t) slots -> robot id
+class ReservationTable
+{
+public:
+	/**
+	 * Function: reserve()
+	 * Use: Claim tile (x,y) at time 't' for 'robot' (overwrites any previous claim)
+	 *
+	 * @param x The tile column
+	 * @param y The tile row
+	 * @param t The time step
+	 * @param robot The claiming robot id
+	 * @return void
+	 */
+	void reserve(unsigned int x, unsigned int y, unsigned int t, uint32_t robot)
+	{
+		slots.insert(packKey(x, y, t), robot) = robot;
+	}
+
+	/**
+	 * Function: release()
+	 * Use: Free tile (x,y) at time 't' if 'robot' holds it
+	 *
+	 * @param x The tile column
+	 * @param y The tile row
+	 * @param t The time step
+	 * @param robot The robot giving up the slot
+	 * @return void
+	 */
+	void release(unsigned int x, unsigned int y, unsigned int t, uint32_t robot)
+	{
+		uint32_t *owner = slots.find(packKey(x, y, t));
+		if(owner != NULL && *owner == robot)
+			*owner = NO_ROBOT;
+	}
+	/**
+	 * Function: getOwner()
+	 *
+	 * @param x The tile column
+	 * @param y The tile row
+	 * @param t The time step
+	 * @return uint32_t The robot holding the slot (NO_ROBOT if free)
+	 */
+	uint32_t getOwner(unsigned int x, unsigned int y, unsigned int t) const
+	{
+		const uint32_t *owner = slots.find(packKey(x, y, t));
+		return (owner == NULL) ? NO_ROBOT : *owner;
+	}
+
+	/**
+	 * Function: clear()
+	 * Use: Free every slot (keeps the allocation)
+	 *
+	 * @param void
+	 * @return void
+	 */
+	void clear() { slots.clear(); }
+
+	/**
+	 * Function: getSize()
+	 *
+	 * @param void
+	 * @return size_t Number of slots ever claimed since clear() (released ones included)
+	 */
+	size_t getSize() const { return slots.getSize(); }
+
+private:
+
+	SlotTable slots;
+
+	/**
+	 * Function: packKey()
+	 *
+	 * @return uint64_t The (x,y,t) slot packed into one key (20 bits x, 20 bits y, 24 bits t)
+	 */
+	static uint64_t packKey(unsigned int x, unsigned int y, unsigned int t)
+	{
+		return ((uint64_t)t << 40) | ((uint64_t)y << 20) | (uint64_t)x;
+	}
+};
+
+// True (obstacle-aware) distance to one goal, computed lazily by a Reverse Resumable A*
+// The reverse search runs from the goal toward the robot's start, and is resumed whenever
+// a tile that isn't closed yet is asked for. Every move (straight or diagonal) counts as
+// one time step, matching the space-time search
+class ReverseDistance
+{
+public:
+	/**
+	 * Function: ReverseDistance(const GameMap &game_map, const PosTile &goal, const PosTile &start)
+	 * Use: Prepares the reverse search (nothing is expanded until getDistance())
+	 *
+	 * @param game_map The traversability map
+	 * @param goal The robot's goal (the reverse search starts here)
+	 * @param start The robot's start (the reverse search is guided toward it)
+	 */
+	ReverseDistance(const GameMap &game_map, const PosTile &goal, const PosTile &start);
+
+	/**
+	 * Function: getDistance()
+	 * Use: Fetch the number of steps from (x,y) to the goal, resuming the reverse search if needed
+	 *
+	 * @param x The tile column
+	 * @param y The tile row
+	 * @return uint32_t Steps to the goal (DIST_UNREACHABLE if there is no route)
+	 */
+	uint32_t getDistance(unsigned int x, unsigned int y);
+
+	/**
+	 * Function: getNumExpanded()
+	 *
+	 * @param void
+	 * @return unsigned long Number of tiles the reverse search has closed
+	 */
+	unsigned long getNumExpanded() const { return num_expanded; }
+
+private:
+
+	// Open list entry (the bucket it sits in gives its F)
+	struct ReverseNode
+	{
+		uint32_t G, tile;
+	};
+
+	const GameMap *game_map_ptr;
+	PosTile start_pos;
+	unsigned long num_expanded;
+
+	// Best G per tile (CLOSED_FLAG set once the tile is final)
+	SlotTable g_vals;
+
+	// Open list as one bucket per F value. Every move costs one and the heuristic is
+	// consistent, so F never drops below the current bucket, and pushes/pops are O(1)
+	// Each bucket is popped last-in first-out, which favours larger G on F ties
+	vector< vector<ReverseNode> > open_buckets;
+	uint32_t cur_F;
+};
+
+// Planned route of one robot
+struct RobotPlan
+{
+	PosTile start, goal;
+	vector<PosTile> path;	// One tile per time step, path[0] = start
+	bool reachable;			// 'false' if no route to the goal exists (the robot waits in place)
+};
+
+class CooperativePlanner
+{
+public:
+	//---------------------------------------------------------------------
+	// Constructors/Destructor
+	//---------------------------------------------------------------------
+	/**
+	 * Function: CooperativePlanner(const GameMap &game_map, unsigned int window_arg)
+	 * Use: Initialization constructor
+	 *
+	 * @param game_map The traversability map (must outlive the planner)
+	 * @param window_arg Number of time steps each robot searches ahead per round
+	 *                   (half of it is committed per round)
+	 */
+	CooperativePlanner(const GameMap &game_map, unsigned int window_arg);
+
+	/**
+	 * Function: ~CooperativePlanner()
+	 * Use: Destructor
+	 *
+	 * @param void
+	 */
+	~CooperativePlanner();
+
+	/**
+	 * Function: addRobot()
+	 * Use: Add a robot (lower ids get priority in the first round, then priority rotates)
+	 *
+	 * @param start The start [x,y] tile
+	 * @param goal The goal [x,y] tile
+	 * @return unsigned int The robot id
+	 */
+	unsigned int addRobot(const PosTile &start, const PosTile &goal);
+
+	/**
+	 * Function: planAll()
+	 * Use: Plan every robot, one window at a time, until all are at their goals
+	 *      Robots that cannot reach their goal at all wait in place, and don't hold up the finish
+	 *      A robot that has to wait in place holds its tile for the whole window (the round is
+	 *      planned again if a robot only finds that out during the round), so no two robots ever
+	 *      share a tile or trade tiles in one step
+	 *
+	 * @param max_time The time step at which to give up
+	 * @return bool 'true' if every robot that can reach its goal did so by 'max_time'
+	 */
+	bool planAll(unsigned int max_time);
+
+	//---------------------------------------------------------------------
+	// Fetch functions
+	//---------------------------------------------------------------------
+	/**
+	 * Function: getPath()
+	 *
+	 * @param robot The robot id
+	 * @return The robot's planned tiles, one per time step
+	 */
+	const vector<PosTile> &getPath(unsigned int robot) const { return robots[robot].path; }
+	/**
+	 * Function: getReachable()
+	 *
+	 * @param robot The robot id
+	 * @return 'false' if the robot has no route to its goal (known after planAll())
+	 */
+	bool getReachable(unsigned int robot) const { return robots[robot].reachable; }
+	/**
+	 * Function: getNumRobots()
+	 *
+	 * @param void
+	 * @return unsigned int The number of robots
+	 */
+	unsigned int getNumRobots() const { return robots.size(); }
+	/**
+	 * Function: getNumExpanded()
+	 *
+	 * @param void
+	 * @return unsigned long Space-time nodes expanded by all planAll() calls
+	 */
+	unsigned long getNumExpanded() const { return num_expanded; }
+
+private:
+
+	// Space-time search node
+	struct TimeNode
+	{
+		unsigned int x, y, depth;	// Tile, and time steps since the window started
+		uint32_t G, F;
+		int parent;					// Index in the node pool (-1 for the window start)
+	};
+
+	const GameMap *game_map_ptr;
+	unsigned int window;
+	unsigned long num_expanded;
+
+	vector<RobotPlan> robots;
+	vector<ReverseDistance> distances;
+	ReservationTable reservations;
+
+	// Connected region of each tile (row-major), filled on the first planAll()
+	vector<uint32_t> component_labels;
+
+	/**
+	 * Function: labelComponents()
+	 * Use: Flood fill the map into connected regions (two tiles are connected
+	 *      if some route of robot moves joins them)
+	 *
+	 * @param void
+	 * @return void
+	 */
+	void labelComponents();
+
+	/**
+	 * Function: planWindow()
+	 * Use: Space-time A* for one robot from its position at 'start_time', 'window' steps deep
+	 *      Claims the planned tile-time slots (in place of any hold on its start tile), and
+	 *      appends the committed steps to the path (waiting in place if no route fills the window)
+	 *
+	 * @param robot The robot id
+	 * @param start_time The time step the window starts at
+	 * @param commit_steps Number of steps to append to the robot's path
+	 * @param plan Scratch space for the window's tiles (size window + 1 on return)
+	 * @return bool 'false' if no route filled the window (the robot waits in place)
+	 */
+	bool planWindow(unsigned int robot, unsigned int start_time, unsigned int commit_steps,
+	                vector<PosTile> &plan);
+};
+
+
+
+#endif /* COOPERATIVEPLANNER_HPP_ */
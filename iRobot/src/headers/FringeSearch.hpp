@@ -0,0 +1,261 @@
+/**
+ * FringeSearch.hpp
+ *  Created on: Oct 18, 2026
+ *      Author: iRobot maintainers
+ *     Purpose: Low-memory path engine (fringe search) for boards that can't hold AStar's planes
+ *              Searches in F-threshold iterations like IDA*, but keeps the fringe between them
+ *              (a "now" and a "later" list) and a compact G cache, so nothing is re-searched
+ *              The G cache only holds the tiles reached (hashed, 8 bytes a slot) until the hash would
+ *              pass half the size of a plane of 4 bytes per tile, then switches to the plane
+ *              All of its memory is bounded by a configurable byte cap; hitting the cap stops the
+ *              search with SearchStatus::SEARCH_MEMORY_LIMIT
+ */
+
+#ifndef FRINGESEARCH_HPP_
+#define FRINGESEARCH_HPP_
+
+#include "../headers/Includes.h"
+#include "../headers/GameMap.hpp"
+#include "../headers/AStar.hpp"
+
+#include <cstdint>
+
+// Default memory cap (G cache plus both lists, see Includes.h)
+#define FRINGE_DEFAULT_MAX_BYTES	((size_t)FRINGE_MAX_KB*1024)
+
+// Starting number of hashed G cache slots (power of two)
+#define FRINGE_INIT_SLOTS	1024
+
+// Move costs in whole G units (1 and 1.4, as in AStar)
+#define FRINGE_COST_UNITS		5.0f
+#define FRINGE_STRAIGHT_COST	5
+#define FRINGE_DIAGONAL_COST	7
+
+// G cache value of a tile not reached yet (also the tile index of an empty hash slot)
+#define FRINGE_UNREACHED	0xFFFFFFFFu
+
+using namespace std;
+
+class FringeSearch
+{
+public:
+	//---------------------------------------------------------------------
+	// Constructors/Destructor
+	//---------------------------------------------------------------------
+	/**
+	 * Function: FringeSearch(const GameMap &game_map, const PosTile &start_pos_arg, const PosTile &end_pos_arg, float robot_radius_arg, size_t max_bytes_arg)
+	 * Use: Initialization constructor
+	 *      Keeps a pointer to game_map, so game_map must outlive the search
+	 *
+	 * @param game_map The traversability map
+	 * @param start_pos_arg The start [x,y] tile
+	 * @param end_pos_arg The end [x,y] tile
+	 * @param robot_radius_arg The robot radius (see GameMap::isPassable())
+	 * @param max_bytes_arg The memory cap for the search (G cache and lists)
+	 */
+	FringeSearch(const GameMap &game_map, const PosTile &start_pos_arg, const PosTile &end_pos_arg,
+	             float robot_radius_arg = 0.0f, size_t max_bytes_arg = FRINGE_DEFAULT_MAX_BYTES);
+
+	/**
+	 * Function: ~FringeSearch()
+	 * Use: Destructor
+	 *      Records the fringe high-water mark (if MEM_PROFILE)
+	 *
+	 * @param void
+	 */
+	~FringeSearch();
+
+	/**
+	 * Function: advance()
+	 * Use: Visit up to 'max_visits' fringe entries, then return control (same use as AStar::advance())
+	 *
+	 * @param max_visits The maximum number of fringe entries to visit in this call
+	 * @return SearchStatus::Type The status of the search after this call
+	 */
+	SearchStatus::Type advance(unsigned long max_visits);
+
+	/**
+	 * Function: getPath()
+	 * Use: Compile the tile positions from the start point to the end point
+	 *      If the path has not been found, compiles the path to the best tile reached
+	 *
+	 * @param path The return path
+	 * @return void
+	 */
+	void getPath(vector<PosTile> &path) const;
+
+	//---------------------------------------------------------------------
+	// Fetch functions
+	//---------------------------------------------------------------------
+	/**
+	 * Function: getStatus()
+	 *
+	 * @param void
+	 * @return SearchStatus::Type The current status of the search
+	 */
+	SearchStatus::Type getStatus() const { return status; }
+	/**
+	 * Function: getIterationNum()
+	 *
+	 * @param void
+	 * @return unsigned long Number of tiles expanded so far
+	 */
+	unsigned long getIterationNum() const { return iteration_num; }
+	/**
+	 * Function: getNumThresholds()
+	 *
+	 * @param void
+	 * @return unsigned int Number of F thresholds (iterations) used so far
+	 */
+	unsigned int getNumThresholds() const { return num_thresholds; }
+	/**
+	 * Function: getPeakBytes()
+	 *
+	 * @param void
+	 * @return size_t Most memory the search has held at once (G cache and lists)
+	 */
+	size_t getPeakBytes() const { return peak_bytes; }
+	/**
+	 * Function: getNumReached()
+	 *
+	 * @param void
+	 * @return size_t Number of tiles in the G cache (tiles reached)
+	 */
+	size_t getNumReached() const { return num_reached; }
+	/**
+	 * Function: getMaxFringeSize()
+	 *
+	 * @param void
+	 * @return size_t Largest number of entries on the two lists together so far
+	 */
+	size_t getMaxFringeSize() const { return max_fringe_size; }
+	/**
+	 * Function: isCacheDense()
+	 *
+	 * @param void
+	 * @return bool 'true' once the G cache has switched to a plane
+	 */
+	bool isCacheDense() const { return !cache_plane.empty(); }
+
+private:
+
+	// One hashed G cache slot: tile, and its G (in FRINGE_COST_UNITS, high 28 bits) with
+	// the direction moved from its parent (low 4 bits, MoveDir::NUM_DIRS for the start)
+	struct CacheSlot
+	{
+		uint32_t tile;
+		uint32_t G_dir;
+	};
+
+	// One list entry, with the G it was queued with (stale once the tile's G is lower)
+	struct FringeEntry
+	{
+		uint32_t tile;
+		uint32_t G;
+	};
+
+	// The map, and the query
+	const GameMap *game_map_ptr;
+	unsigned int map_width, map_height;
+	PosTile start_pos, end_pos;
+	float robot_radius;
+
+	// Status, and the reached tile closest to the end point
+	SearchStatus::Type status;
+	uint32_t best_tile;
+	float best_H;
+
+	// The G cache: hashed (open addressing, linear probing, 2^cache_bits slots),
+	// or a plane of G_dir values once that's smaller
+	vector<CacheSlot> cache_slots;
+	vector<uint32_t> cache_plane;
+	unsigned int cache_bits;
+	size_t num_reached;
+
+	// The fringe: entries at or under the threshold, and entries over it (for the next iteration)
+	vector<FringeEntry> now_list, later_list;
+	float threshold, next_threshold;
+
+	// Counters and the memory cap
+	unsigned long iteration_num;
+	unsigned int num_thresholds;
+	size_t max_fringe_size;
+	size_t max_bytes, peak_bytes;
+
+	/**
+	 * Function: calcH()
+	 *
+	 * @param tile The tile index (y*map_width + x)
+	 * @return float Heuristic distance to the end point (octile distance, whatever ASTAR_HEURISTIC_OCTILE is)
+	 */
+	float calcH(uint32_t tile) const;
+
+	/**
+	 * Function: findSlot()
+	 *
+	 * @param tile The tile index
+	 * @return size_t The tile's hash slot (or the empty slot it would go in)
+	 */
+	size_t findSlot(uint32_t tile) const;
+
+	/**
+	 * Function: getGDir()
+	 *
+	 * @param tile The tile index
+	 * @return uint32_t The tile's G_dir value (FRINGE_UNREACHED if not reached)
+	 */
+	uint32_t getGDir(uint32_t tile) const
+	{
+		if(!cache_plane.empty())
+			return cache_plane[tile];
+		const CacheSlot &slot = cache_slots[findSlot(tile)];
+		return (slot.tile == tile) ? slot.G_dir : FRINGE_UNREACHED;
+	}
+
+	/**
+	 * Function: setG()
+	 * Use: Cache a tile's G and parent direction, and queue it on the "now" list
+	 *
+	 * @param tile The tile index
+	 * @param G The tile's new G (in FRINGE_COST_UNITS)
+	 * @param dir The direction moved from the parent (MoveDir::NUM_DIRS for the start)
+	 * @return bool 'false' if it would go over the memory cap
+	 */
+	bool setG(uint32_t tile, uint32_t G, unsigned int dir);
+
+	/**
+	 * Function: growCache(), growList()
+	 * Use: Double the hashed G cache (or switch it to a plane) / drop a list's stale
+	 *      entries, and double it if that didn't free half of it, if the memory cap allows it
+	 *
+	 * @return bool 'false' if it would go over the memory cap
+	 */
+	bool growCache();
+	bool growList(vector<FringeEntry> &list);
+
+	/**
+	 * Function: getBytes()
+	 *
+	 * @param void
+	 * @return size_t The memory the search holds now
+	 */
+	size_t getBytes() const
+	{
+		return cache_slots.capacity()*sizeof(CacheSlot) + cache_plane.capacity()*sizeof(uint32_t) +
+		       (now_list.capacity() + later_list.capacity())*sizeof(FringeEntry);
+	}
+
+	/**
+	 * Function: visit()
+	 * Use: Take the next "now" entry: expand it if it's under the threshold,
+	 *      otherwise move it to the "later" list
+	 *
+	 * @param void
+	 * @return void
+	 */
+	void visit();
+};
+
+
+
+#endif /* FRINGESEARCH_HPP_ */
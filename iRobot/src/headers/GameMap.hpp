@@ -9,6 +9,37 @@
 #define GAMEMAP_HPP_
 
 #include "../headers/Includes.h"
+#include "../headers/GridKernels.hpp"
+
+#include <cstdint>
+#include <memory>
+
+// Clearance value for tiles with no obstacle anywhere on the map
+#define CLEARANCE_NONE	(1.0e30f)
+
+// Number of map tiles per bit word (map rows are padded to whole words)
+#define MAP_WORD_BITS	64
+
+// Number of map rows per page (see MapPage)
+#define MAP_PAGE_ROWS	64
+
+// One band of MAP_PAGE_ROWS map rows (fewer for the last page)
+// Pages are never changed once built. Copies of a GameMap share them, and an obstacle
+// update only builds new pages where the contents changed (copy-on-write), so a copy of
+// the map is a cheap, immutable snapshot
+struct MapPage
+{
+	std::vector<uint64_t> words;	// Traversability bits, row-major (see GameMap::getTraversableRow())
+	std::vector<float> clearance;	// Clearance, row-major (see GameMap::getClearance())
+	float max_clearance;			// Largest clearance in the page (bounds how far an update reaches)
+
+	/**
+	 * Function: MapPage(), ~MapPage()
+	 * Use: Keep count of the pages alive in the process (see GameMap::getNumLivePages())
+	 */
+	MapPage();
+	~MapPage();
+};
 
 class GameMap
 {
@@ -27,17 +58,69 @@ public:
 	GameMap();
 
 	/**
-	 * Function: GameMap(const Json::Value &obstacles, unsigned int max_width, int max_height)
+	 * Function: GameMap(const Json::Value &obstacles, unsigned int max_width, int max_height, PosTile *max_obs)
 	 * Use: Initialization constructor
 	 *      Creates 2D bool matrix of specified (max_width,max_height), all initialize to 'true'
-	 *      Initializes obstacle tiles to 'false'
+	 *      Initializes obstacle tiles to 'false' (in parallel, see rasteriseObstacles())
+	 *      Computes the obstacle clearance of every tile (see calcClearance())
 	 *      if(DEBUG), automatically creates obstacles for traversal, rather than load from JSON
 	 *
-	 * @param obstacles JSON formatted array of [x,y] tile locations
+	 * @param obstacles JSON formatted array of obstacle primitives: [x,y] tiles,
+	 *                  [x,y,length] horizontal runs, and [x,y,width,height] rectangles
 	 * @param max_width The width for the map
 	 * @param max_height The height for the map
+	 * @param max_obs The return largest x/y any obstacle covers (optional)
+	 */
+	GameMap(const Json::Value &obstacles, unsigned int max_width, int max_height, PosTile *max_obs = NULL);
+
+	/**
+	 * Function: GameMap(const std::vector<uint64_t> &obstacle_words, unsigned int map_width, unsigned int map_height)
+	 * Use: Initialization constructor from packed obstacle bits (see MapGenerator)
+	 *      Computes the obstacle clearance of every tile (see calcClearance())
+	 *
+	 * @param obstacle_words Row-major obstacle bits (bit set = obstacle), rows padded to whole 64-bit words
+	 * @param map_width The width for the map
+	 * @param map_height The height for the map
 	 */
-	GameMap(const Json::Value &obstacles, unsigned int max_width, int max_height);
+	GameMap(const std::vector<uint64_t> &obstacle_words, unsigned int map_width, unsigned int map_height);
+
+	/**
+	 * Function: loadFile()
+	 * Use: Replace the map with one loaded from a map file
+	 *      '.bin' files are loaded with loadBinary(), anything else with loadJson()
+	 *      Failures are reported to the console
+	 *
+	 * @param file_name The map file
+	 * @param robot_start The return start [x,y] tile stored in the file
+	 * @param robot_end The return end [x,y] tile stored in the file
+	 * @return bool 'true' on success
+	 */
+	bool loadFile(const std::string &file_name, PosTile &robot_start, PosTile &robot_end);
+
+	/**
+	 * Function: loadJson()
+	 * Use: Replace the map with one loaded from a JSON 'set#.dat' file
+	 *      The map is "width" x "height" if given, (1500,1500) otherwise
+	 *      if(DEBUG), uses a (20,20) map with generated obstacles instead
+	 *
+	 * @param file_name The JSON map file
+	 * @param robot_start The return start [x,y] tile stored in the file
+	 * @param robot_end The return end [x,y] tile stored in the file
+	 * @return bool 'true' on success
+	 */
+	bool loadJson(const std::string &file_name, PosTile &robot_start, PosTile &robot_end);
+
+	/**
+	 * Function: loadBinary()
+	 * Use: Replace the map with one loaded from a binary map file (see README.txt)
+	 *
+	 * @param file_name The binary map file
+	 * @param robot_start The return start [x,y] tile stored in the file
+	 * @param robot_end The return end [x,y] tile stored in the file
+	 * @return bool 'true' on success ('false' for a truncated file, a zero width/height,
+	 *              or start/end outside the map)
+	 */
+	bool loadBinary(const std::string &file_name, PosTile &robot_start, PosTile &robot_end);
 
 	/**
 	 * Function: ~GameMap()
@@ -47,6 +130,21 @@ public:
 	 */
 	~GameMap();
 
+	/**
+	 * Function: updateObstacles()
+	 * Use: Set a batch of tiles to traversable/obstacle, recompute the clearance around them,
+	 *      and move the map to a new version (see getVersion())
+	 *      Only the pages whose contents change are copied and edited; copies of the map made
+	 *      before the update keep the old pages, and don't see the change
+	 *      The clearance is recomputed in a band around the changed tiles, as wide as the
+	 *      largest clearance of the pages it can reach
+	 *
+	 * @param tiles The tiles to change
+	 * @param traversable The new traversability of the tiles
+	 * @return void
+	 */
+	void updateObstacles(const std::vector<PosTile> &tiles, bool traversable);
+
 	//---------------------------------------------------------------------
 	// Fetch functions
 	//---------------------------------------------------------------------
@@ -56,18 +154,23 @@ public:
 	 * @param void
 	 * @return Height of the game map
 	 */
-	unsigned int getHeight() const { return the_map.size(); }
+	unsigned int getHeight() const { return map_height; }
 	/**
 	 * Function: getWidth()
 	 *
 	 * @param void
 	 * @return Width of the game map
 	 */
-	unsigned int getWidth() const
-	{
-		if(getHeight() == 0)	return 0;
-		else					return the_map[0].size();
-	}
+	unsigned int getWidth() const { return map_width; }
+	/**
+	 * Function: getVersion()
+	 * Use: Version of the map contents, unique across all GameMaps in the process
+	 *      Changes every time obstacles are updated
+	 *
+	 * @param void
+	 * @return The map version
+	 */
+	unsigned long getVersion() const { return version; }
 	/**
 	 * Function: getTraversable()
 	 *
@@ -75,21 +178,216 @@ public:
 	 * @param y The tile row
 	 * @return Traversability of specified tile (true/false)
 	 */
-	bool getTraversable(unsigned int x, unsigned int y) const { return the_map[y][x]; }
+	bool getTraversable(unsigned int x, unsigned int y) const
+	{
+		return (traversable_rows[y][x/MAP_WORD_BITS] >> (x%MAP_WORD_BITS)) & 1;
+	}
+	/**
+	 * Function: getTraversableRow()
+	 * Use: Fetch one row of traversability bits, for whole-row passes
+	 *      Bit x%64 of word x/64 is set if tile x is traversable (padding bits are clear)
+	 *
+	 * @param y The tile row
+	 * @return const uint64_t* The row's getRowWords() words
+	 */
+	const uint64_t *getTraversableRow(unsigned int y) const { return traversable_rows[y]; }
+	/**
+	 * Function: getRowWords()
+	 *
+	 * @param void
+	 * @return Number of traversability words per map row
+	 */
+	unsigned int getRowWords() const { return row_words; }
+	/**
+	 * Function: countTraversable()
+	 *
+	 * @param void
+	 * @return Number of traversable tiles on the map
+	 */
+	size_t countTraversable() const;
+	/**
+	 * Function: findTraversable()
+	 * Use: Scan along a row for the next traversable tile
+	 *
+	 * @param x The first tile column to look at
+	 * @param y The tile row
+	 * @return The column of the first traversable tile at or after 'x' (getWidth() if there is none)
+	 */
+	unsigned int findTraversable(unsigned int x, unsigned int y) const
+	{
+		if(x >= map_width)
+			return map_width;
+
+		// Usually the tile's own word has one (padding bits are clear, so it's on the map),
+		// otherwise scan the rest of the row a block of words at a time
+		uint64_t word = traversable_rows[y][x/MAP_WORD_BITS] >> (x%MAP_WORD_BITS);
+		if(word != 0)
+			return x + __builtin_ctzll(word);
+		return kernelFindBit(getTraversableRow(y), x, map_width);
+	}
+	/**
+	 * Function: getClearance()
+	 *
+	 * @param x The tile column
+	 * @param y The tile row
+	 * @return Euclidean distance (in tiles) from the tile to the nearest obstacle tile
+	 *         (0 for obstacles, CLEARANCE_NONE if the map has no obstacles)
+	 */
+	float getClearance(unsigned int x, unsigned int y) const { return clearance_rows[y][x]; }
+	/**
+	 * Function: isPassable()
+	 * Use: Check whether a round robot of 'robot_radius' can be centered on a tile
+	 *      A tile is blocked if it's an obstacle, or its clearance is below the radius
+	 *      A radius of 0 is a single-point robot (same as getTraversable())
+	 *
+	 * @param x The tile column
+	 * @param y The tile row
+	 * @param robot_radius The robot radius (in tiles)
+	 * @return Passability of specified tile (true/false)
+	 */
+	bool isPassable(unsigned int x, unsigned int y, float robot_radius) const
+	{
+		return getTraversable(x, y) && (robot_radius <= 0.0f || getClearance(x, y) >= robot_radius);
+	}
+	/**
+	 * Function: getNumPages()
+	 *
+	 * @param void
+	 * @return Number of pages the map is split into
+	 */
+	unsigned int getNumPages() const { return pages.size(); }
+	/**
+	 * Function: countSharedPages()
+	 *
+	 * @param other Another map
+	 * @return Number of pages this map shares with 'other' (same page at the same place)
+	 */
+	unsigned int countSharedPages(const GameMap &other) const;
+	/**
+	 * Function: getNumLivePages()
+	 *
+	 * @param void
+	 * @return Number of pages alive across every GameMap in the process
+	 *         (pages are freed when the last map holding them goes away)
+	 */
+	static long getNumLivePages();
 
 private:
 
-	// The map (a bool vector matrix showing whether each tile is/isn't traversable)
-	std::vector< std::vector<bool> > the_map;
+	// The map, as shared immutable pages of rows (see MapPage)
+	// Traversability is packed into words so whole-row passes can count and scan 64 tiles at a time
+	std::vector< std::shared_ptr<const MapPage> > pages;
+
+	// Start of each row's traversability words and clearance values, within its page
+	std::vector<const uint64_t *> traversable_rows;
+	std::vector<const float *> clearance_rows;
+
+	// Map width/height, and bit words per row
+	unsigned int map_width, map_height, row_words;
+
+	/**
+	 * Function: initFromWords()
+	 * Use: Build the map from packed obstacle bits (see GameMap(obstacle_words, ...))
+	 *
+	 * @param obstacle_words Row-major obstacle bits (bit set = obstacle)
+	 * @param width_arg The width for the map
+	 * @param height_arg The height for the map
+	 */
+	void initFromWords(const std::vector<uint64_t> &obstacle_words, unsigned int width_arg, unsigned int height_arg);
+
+	/**
+	 * Function: initOpen()
+	 * Use: Size the map, and fill the traversability words for an all-traversable map
+	 *      The map has no pages until setContents()
+	 *
+	 * @param width_arg The width for the map
+	 * @param height_arg The height for the map
+	 * @param words The return traversability words (row-major, getRowWords() per row)
+	 */
+	void initOpen(unsigned int width_arg, unsigned int height_arg, std::vector<uint64_t> &words);
+
+	/**
+	 * Function: setContents()
+	 * Use: Compute the clearance field for new traversability words, and split both into pages
+	 *      Pages whose contents match the current ones are kept (shared), the others are replaced
+	 *
+	 * @param words The traversability words (row-major, getRowWords() per row)
+	 */
+	void setContents(const std::vector<uint64_t> &words);
+
+	/**
+	 * Function: pointRows()
+	 * Use: Point the traversability and clearance rows of a page into it
+	 *
+	 * @param page_idx The page
+	 */
+	void pointRows(unsigned int page_idx);
+
+	/**
+	 * Function: rasteriseObstacles()
+	 * Use: Clear the traversable bits of every obstacle primitive, with the array split across
+	 *      threads (primitives from different threads can share a word, so bits are cleared
+	 *      with atomic ANDs, a whole word span per row of a run or rectangle)
+	 *      Parts of primitives outside the map are ignored
+	 *
+	 * @param obstacles JSON formatted array of obstacle primitives (see GameMap())
+	 * @param words The traversability words (row-major, getRowWords() per row)
+	 * @param max_obs The return largest x/y any obstacle covers (0 if there are none)
+	 */
+	void rasteriseObstacles(const Json::Value &obstacles, std::vector<uint64_t> &words, PosTile &max_obs) const;
+
+	/**
+	 * Function: setTraversable()
+	 *
+	 * @param words The traversability words (row-major, getRowWords() per row)
+	 * @param x The tile column
+	 * @param y The tile row
+	 * @param traversable The new traversability of the tile
+	 */
+	void setTraversable(std::vector<uint64_t> &words, unsigned int x, unsigned int y, bool traversable) const
+	{
+		uint64_t &word = words[(size_t)y*row_words + x/MAP_WORD_BITS];
+		uint64_t bit = (uint64_t)1 << (x%MAP_WORD_BITS);
+		word = traversable ? (word | bit) : (word & ~bit);
+	}
+
+	// Version of the map contents (see getVersion())
+	unsigned long version;
+
+	/**
+	 * Function: nextVersion()
+	 * Use: Hands out process-wide unique map versions
+	 *
+	 * @param void
+	 * @return A new map version
+	 */
+	static unsigned long nextVersion();
+
+	/**
+	 * Function: calcClearance()
+	 * Use: Computes the clearance field of a window of the map with a separable Euclidean distance transform
+	 *      Pass 1 runs down the columns (blocks of columns per thread, vectorised across a row)
+	 *      Pass 2 takes the lower envelope of parabolas along each row (blocks of rows per thread)
+	 *      Tiles outside the window are not treated as obstacles
+	 *
+	 * @param rows The traversability words of each map row (getRowWords() per row)
+	 * @param win_x0 The window's first column
+	 * @param win_y0 The window's first row
+	 * @param win_width The window width
+	 * @param win_height The window height
+	 * @param clearance The return clearance field of the window (row-major)
+	 */
+	void calcClearance(const uint64_t *const *rows, unsigned int win_x0, unsigned int win_y0,
+	                   unsigned int win_width, unsigned int win_height, std::vector<float> &clearance) const;
 
 	/**
 	 * Function: createObstacles()
 	 * Use: Creates obstacles in the game map (1/2 of total tiles)
 	 *      For use in debugging
 	 *
-	 * @param void
+	 * @param words The traversability words to add the obstacles to
 	 */
-	void createObstacles();
+	void createObstacles(std::vector<uint64_t> &words);
 
 public:
 	/**
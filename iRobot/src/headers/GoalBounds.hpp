@@ -0,0 +1,191 @@
+/**
+ * GoalBounds.hpp
+ *  Created on: Oct 18, 2026
+ *      Author: iRobot maintainers
+ *     Purpose: Goal-bounding preprocessing for static maps
+ *              Stores, for every tile and each of its 8 moves, the bounding box of the goals that
+ *              some shortest path from the tile starts with that move. A search can then skip
+ *              any move whose box doesn't hold its end point, and still find a shortest path
+ *              Built with one Dijkstra sweep per tile (in parallel), so it only suits small and
+ *              medium maps (see GOAL_BOUNDS_MAX_TILES); kept in a side file that is memory-mapped
+ *              Valid for single-point robots (radius 0) only. See README.txt for the side file format
+ */
+
+#ifndef GOALBOUNDS_HPP_
+#define GOALBOUNDS_HPP_
+
+#include "../headers/Includes.h"
+#include "../headers/GameMap.hpp"
+
+#include <cstdint>
+
+// Magic number at the start of a goal bounds file ("IRGB", little-endian)
+#define GOAL_BOUNDS_MAGIC	0x42475249u
+#define GOAL_BOUNDS_VERSION	1
+
+// Largest map build() accepts (the sweeps take time that grows with the square of the tiles)
+#define GOAL_BOUNDS_MAX_TILES	(256*256)
+
+// Header words in front of the boxes in the side file
+#define GOAL_BOUNDS_HEADER_WORDS	6
+
+using namespace std;
+
+// One move's goal box (inclusive); empty (no goals) when min_x > max_x
+struct GoalBox
+{
+	uint16_t min_x, min_y, max_x, max_y;
+};
+
+class GoalBounds
+{
+public:
+	//---------------------------------------------------------------------
+	// Constructors/Destructor
+	//---------------------------------------------------------------------
+	/**
+	 * Function: GoalBounds()
+	 * Use: Creates empty bounds. Call build() or load() before canReach()
+	 *
+	 * @param void
+	 */
+	GoalBounds();
+
+	/**
+	 * Function: ~GoalBounds()
+	 * Use: Destructor
+	 *      Unmaps the side file (if loaded)
+	 *
+	 * @param void
+	 */
+	~GoalBounds();
+
+	// Owns a mapping, so it can't be copied
+	GoalBounds(const GoalBounds &) = delete;
+	GoalBounds &operator =(const GoalBounds &) = delete;
+
+	/**
+	 * Function: build()
+	 * Use: Preprocess a map: one Dijkstra sweep from every tile (split across threads),
+	 *      growing each move's box by every tile a shortest path starting with that move reaches
+	 *      Moves cost 1 straight and 1.4 diagonally, as in AStar (corners may be cut)
+	 *
+	 * @param game_map The traversability map (must not change while the bounds are used)
+	 * @return bool 'false' if the map has more than GOAL_BOUNDS_MAX_TILES tiles, or a side
+	 *              over 65535 (nothing built)
+	 */
+	bool build(const GameMap &game_map);
+
+	/**
+	 * Function: save()
+	 * Use: Write the bounds to a side file (see README.txt)
+	 *
+	 * @param file_name The output file
+	 * @return bool 'true' on success
+	 */
+	bool save(const string &file_name) const;
+
+	/**
+	 * Function: load()
+	 * Use: Map a side file written by save() into memory (the boxes are read in place)
+	 *      Fails if the file was built from a different map (size or obstacles)
+	 *
+	 * @param file_name The side file
+	 * @param game_map The traversability map (must not change while the bounds are used)
+	 * @return bool 'true' on success
+	 */
+	bool load(const string &file_name, const GameMap &game_map);
+
+	/**
+	 * Function: loadOrBuild()
+	 * Use: load() the side file, or build() and save() it (then load() that) if it is missing or stale
+	 *
+	 * @param file_name The side file
+	 * @param game_map The traversability map (must not change while the bounds are used)
+	 * @return bool 'true' if bounds are ready, 'false' if the map is too large to build them
+	 */
+	bool loadOrBuild(const string &file_name, const GameMap &game_map);
+
+	/**
+	 * Function: canReach()
+	 * Use: Check whether a move can start a shortest path to the goal
+	 *
+	 * @param x The tile column
+	 * @param y The tile row
+	 * @param dir The move (MoveDir::Type)
+	 * @param goal The goal [x,y] tile
+	 * @return bool 'false' if no shortest path to 'goal' starts with this move
+	 */
+	bool canReach(unsigned int x, unsigned int y, unsigned int dir, const PosTile &goal) const
+	{
+		const GoalBox &box = boxes[((size_t)y*map_width + x)*8 + dir];
+		return goal.x >= box.min_x && goal.x <= box.max_x && goal.y >= box.min_y && goal.y <= box.max_y;
+	}
+
+	/**
+	 * Function: getSideFileName()
+	 *
+	 * @param map_file_name The map file
+	 * @return string The side file the bounds for that map are saved to
+	 */
+	static string getSideFileName(const string &map_file_name) { return map_file_name + ".gbd"; }
+
+	//---------------------------------------------------------------------
+	// Fetch functions
+	//---------------------------------------------------------------------
+	/**
+	 * Function: isReady()
+	 *
+	 * @param void
+	 * @return bool 'true' once bounds have been built or loaded
+	 */
+	bool isReady() const { return boxes != NULL; }
+	/**
+	 * Function: isMapped()
+	 *
+	 * @param void
+	 * @return bool 'true' if the boxes are read from a memory-mapped side file
+	 */
+	bool isMapped() const { return mapped_bytes > 0; }
+	/**
+	 * Function: getWidth(), getHeight()
+	 *
+	 * @param void
+	 * @return unsigned int Size of the map the bounds were built for
+	 */
+	unsigned int getWidth() const { return map_width; }
+	unsigned int getHeight() const { return map_height; }
+	/**
+	 * Function: getNumBytes()
+	 *
+	 * @param void
+	 * @return size_t Size of the boxes (8 per tile)
+	 */
+	size_t getNumBytes() const { return (size_t)map_width*map_height*8*sizeof(GoalBox); }
+
+private:
+
+	// The map the bounds were built for
+	unsigned int map_width, map_height;
+	uint64_t map_checksum;
+
+	// Boxes, 8 per tile in MoveDir order (row-major tiles): in built_boxes after build(),
+	// or in the side file's mapping after load()
+	const GoalBox *boxes;
+	vector<GoalBox> built_boxes;
+	void *mapped_data;
+	size_t mapped_bytes;
+
+	/**
+	 * Function: unmap()
+	 * Use: Release the side file's mapping (if any); the boxes are then built_boxes (if any)
+	 *
+	 * @param void
+	 * @return void
+	 */
+	void unmap();
+};
+
+
+
+#endif /* GOALBOUNDS_HPP_ */
@@ -0,0 +1,129 @@
+/**
+ * GridKernels.hpp
+ *  Created on: Oct 18, 2026
+ *      Author: iRobot maintainers
+ *     Purpose: Vectorised kernels for full-grid passes (G/F sentinel fills, heuristic rows,
+ *              counting and scanning traversability words)
+ *              Each kernel has AVX2, SSE4.2 and scalar versions. The best version the CPU
+ *              supports is picked at runtime, so one binary runs on any x86-64 machine
+ *              (other platforms always use the scalar versions)
+ */
+
+#ifndef GRIDKERNELS_HPP_
+#define GRIDKERNELS_HPP_
+
+#include "../headers/Includes.h"
+
+#include <cstdint>
+
+// Fills larger than this (bytes) bypass the cache (streaming stores), since the
+// plane can't stay cached anyway
+#define KERNEL_STREAM_BYTES	(8u << 20)
+
+// Instruction set levels the kernels are built for
+namespace KernelLevel
+{
+	enum Type
+	{
+		KERNEL_SCALAR,	// Plain C++ (any CPU)
+		KERNEL_SSE,		// SSE4.2 + POPCNT, 4 floats / 2 words per step
+		KERNEL_AVX2,	// AVX2 + POPCNT, 8 floats / 4 words per step
+		NUM_LEVELS // DO NOT ADD BELOW THIS
+	} ;
+}
+
+/**
+ * Function: getKernelLevel()
+ *
+ * @param void
+ * @return KernelLevel::Type The level the kernels currently run at
+ *         (the best supported level, unless changed by setKernelLevel())
+ */
+KernelLevel::Type getKernelLevel();
+
+/**
+ * Function: getBestKernelLevel()
+ *
+ * @param void
+ * @return KernelLevel::Type The best level this CPU supports
+ */
+KernelLevel::Type getBestKernelLevel();
+
+/**
+ * Function: setKernelLevel()
+ * Use: Switch every kernel to 'level' (for benchmarks and testing)
+ *      Not safe while other threads are running kernels
+ *
+ * @param level The level to use
+ * @return bool 'false' (and nothing changes) if the CPU doesn't support 'level'
+ */
+bool setKernelLevel(KernelLevel::Type level);
+
+/**
+ * Function: getKernelLevelName()
+ *
+ * @param level The level
+ * @return const char* The level's name ("scalar", "sse4.2", "avx2")
+ */
+const char *getKernelLevelName(KernelLevel::Type level);
+
+/**
+ * Function: kernelFill()
+ * Use: Set every value of a float plane (G/F "uninitialized" sentinels)
+ *
+ * @param values The plane
+ * @param num_values Number of values
+ * @param value The value to store
+ * @return void
+ */
+void kernelFill(float *values, size_t num_values, float value);
+
+/**
+ * Function: kernelManhattanRow()
+ * Use: Manhattan distance from each tile of one row to the goal
+ *      values[x] = |goal_x - x| + row_dist
+ *
+ * @param values The row (map_width values)
+ * @param map_width The row width
+ * @param goal_x The goal column
+ * @param row_dist The row's distance from the goal row (|goal_y - y|)
+ * @return void
+ */
+void kernelManhattanRow(float *values, unsigned int map_width, unsigned int goal_x, unsigned int row_dist);
+
+/**
+ * Function: kernelOctileRow()
+ * Use: Octile distance (1 per straight move, 1.4 per diagonal, as in AStar) from each tile
+ *      of one row to the goal
+ *      values[x] = max(dx, dy) + 0.4*min(dx, dy), with dx = |goal_x - x|, dy = row_dist
+ *
+ * @param values The row (map_width values)
+ * @param map_width The row width
+ * @param goal_x The goal column
+ * @param row_dist The row's distance from the goal row (|goal_y - y|)
+ * @return void
+ */
+void kernelOctileRow(float *values, unsigned int map_width, unsigned int goal_x, unsigned int row_dist);
+
+/**
+ * Function: kernelCountBits()
+ * Use: Count the set bits of packed words (traversable tiles of a GameMap row or map)
+ *
+ * @param words The words
+ * @param num_words Number of words
+ * @return size_t Number of set bits
+ */
+size_t kernelCountBits(const uint64_t *words, size_t num_words);
+
+/**
+ * Function: kernelFindBit()
+ * Use: Scan packed words for the next set bit (the next traversable tile)
+ *
+ * @param words The words (bit 'b' is bit b%64 of words[b/64])
+ * @param begin_bit The first bit to look at
+ * @param end_bit One past the last bit to look at
+ * @return size_t The first set bit in [begin_bit, end_bit) (end_bit if there is none)
+ */
+size_t kernelFindBit(const uint64_t *words, size_t begin_bit, size_t end_bit);
+
+#endif /* GRIDKERNELS_HPP_ */
@@ -25,6 +25,9 @@
 #include <climits>
 #include <algorithm>
 
+// For time-sliced (deadline-bounded) searching
+#include <chrono>
+
 // gcc complains that hash_map is deprecated
 // It ALSO complains that it's replacement 'unordered_map' is experimental
 // Because of this, I have to use vector for my Closed list
@@ -46,7 +49,52 @@ struct PosTile
 
 // Change DEBUG to '0' for production build
 // Change DEBUG to '1' for testing algorithm on small map with process prints
+// Change DEBUG_MAP_SEED to place a different set of random obstacles in DEBUG builds (see createObstacles())
 #define DEBUG 0
+#define DEBUG_MAP_SEED 1
+
+// Path output options (see README.txt)
+// Change PATH_OUT_WAYPOINTS to '1' to write only the turn points of the path
+// Change PATH_OUT_BINARY to '1' to write the binary path format to 'set#_out.bin'
+#define PATH_OUT_WAYPOINTS 0
+#define PATH_OUT_BINARY 0
+
+// A* heuristic option (see README.txt)
+// Change ASTAR_HEURISTIC_OCTILE to '1' to use the octile distance (diagonals cost 1.4) instead
+//  of the Manhattan distance. Expands more tiles, but the paths are always shortest
+#define ASTAR_HEURISTIC_OCTILE 0
+
+// A* tie-break option (see README.txt)
+// Change ASTAR_TIE_BREAK to order Open list nodes with equal F scores: '0' leaves them in sort()
+//  order (F only), '1' puts lower H first, '2' puts higher G first, '3' goes by tile index alone;
+//  '1' and '2' then go by tile index, so with '1'-'3' every build and run expands the same tiles
+//  (see TieBreak in AStar.hpp)
+#define ASTAR_TIE_BREAK 0
+
+// Path engine option (see README.txt)
+// Change PATH_ENGINE_SUBGOAL to '1' to answer the query with a preprocessed subgoal graph
+//  (built and saved to '<map file>.sgr' on the first run, loaded after that), falling back to A*
+//  if the graph finds no path. Its moves differ from A*'s: a diagonal step may not cut an obstacle
+//  corner, so its paths can be longer than A*'s ('bench subgoal', 128x128 generated maze: 196 of
+//  200 paths longer, by up to 63.0 cost units; rooms up to 3.6, warehouse up to 1.8)
+#define PATH_ENGINE_SUBGOAL 0
+
+// Low-memory path engine option (see README.txt)
+// Change PATH_ENGINE_FRINGE to '1' to search with FringeSearch instead of A*: it only stores the
+//  tiles it reaches, and never holds more than FRINGE_MAX_KB of search state
+#define PATH_ENGINE_FRINGE 0
+#define FRINGE_MAX_KB 16384
+
+// Goal bounding option (see README.txt)
+// Change PATH_ENGINE_GOAL_BOUNDS to '1' to prune A*'s moves with goal bounds (built and saved to
+//  '<map file>.gbd' on the first run, memory-mapped after that). Maps over GOAL_BOUNDS_MAX_TILES
+//  tiles are searched without them
+#define PATH_ENGINE_GOAL_BOUNDS 0
+
+// Memory profiling option (see README.txt)
+// Change MEM_PROFILE to '1' to count heap allocations per subsystem, peak RSS per phase and
+//  Open list high-water marks, and print a report at exit. Replaces the global operator new
+#define MEM_PROFILE 0
 
 #endif
 
@@ -0,0 +1,228 @@
+/**
+ * MapGenerator.hpp
+ *  Created on: Oct 18, 2026
+ *      Author: iRobot maintainers
+ *     Purpose: Deterministic (seeded) synthetic map generator for stress and scaling runs
+ *              Generates random-density, maze, rooms-and-corridors and warehouse-aisle maps
+ *              Writes the JSON 'set#.dat' format, the binary map format, and query sets
+ *              See README.txt for the file formats
+ */
+
+#ifndef MAPGENERATOR_HPP_
+#define MAPGENERATOR_HPP_
+
+#include "../headers/Includes.h"
+#include "../headers/GameMap.hpp"
+
+#include <cstdint>
+
+// Magic number at the start of a binary map ("IRMB", little-endian)
+#define MAP_BINARY_MAGIC	0x424D5249u
+#define MAP_BINARY_VERSION	1
+
+using namespace std;
+
+// Map layouts the generator can build
+namespace MapTopology
+{
+	enum Type
+	{
+		TOPO_RANDOM,	// Each tile independently blocked with probability 'density'
+		TOPO_MAZE,		// Perfect maze (one route between any two tiles), 3-tile corridors
+		TOPO_ROOMS,		// Rectangular rooms joined by 2-tile corridors
+		TOPO_WAREHOUSE,	// Rows of shelving racks separated by aisles and cross-aisles
+		NUM_TOPOLOGIES // DO NOT ADD BELOW THIS
+	} ;
+}
+
+// A start/end pair for a generated map
+struct PathQueryPair
+{
+	PosTile start, end;
+};
+
+class MapGenerator
+{
+public:
+	//---------------------------------------------------------------------
+	// Constructors/Destructor
+	//---------------------------------------------------------------------
+	/**
+	 * Function: MapGenerator(unsigned int width_arg, unsigned int height_arg, unsigned long long seed_arg)
+	 * Use: Initialization constructor
+	 *      Creates an empty (fully traversable) map. Call generate() to fill it
+	 *
+	 * @param width_arg The width for the map
+	 * @param height_arg The height for the map
+	 * @param seed_arg The random seed (same seed, size and topology = same map, on any platform)
+	 */
+	MapGenerator(unsigned int width_arg, unsigned int height_arg, unsigned long long seed_arg);
+
+	/**
+	 * Function: ~MapGenerator()
+	 * Use: Destructor
+	 *
+	 * @param void
+	 */
+	~MapGenerator();
+
+	/**
+	 * Function: generate()
+	 * Use: Build the obstacles for a topology (replaces any previous map)
+	 *
+	 * @param topology The map layout
+	 * @param density Fraction of tiles blocked (TOPO_RANDOM only)
+	 * @return void
+	 */
+	void generate(MapTopology::Type topology, double density);
+
+	/**
+	 * Function: generateQueries()
+	 * Use: Pick random start/end pairs on traversable tiles
+	 *      Pairs are not checked for reachability (TOPO_RANDOM maps may be disconnected)
+	 *
+	 * @param num_queries The number of pairs
+	 * @param queries The return pairs
+	 * @return void
+	 */
+	void generateQueries(unsigned int num_queries, vector<PathQueryPair> &queries);
+
+	/**
+	 * Function: writeJson()
+	 * Use: Write the map in the 'set#.dat' JSON format (single line), plus "width"/"height"
+	 *      With use_runs, each row's runs of blocked tiles are written as one [x,y,length] entry
+	 *      (single tiles stay [x,y]), which is much smaller and faster to load on large maps
+	 *
+	 * @param file_name The output file
+	 * @param query The start/end written as "robotStart"/"robotEnd"
+	 * @param use_runs Write horizontal runs instead of single tiles
+	 * @return bool 'true' on success
+	 */
+	bool writeJson(const string &file_name, const PathQueryPair &query, bool use_runs = false) const;
+
+	/**
+	 * Function: writeBinary()
+	 * Use: Write the map in the binary map format (see README.txt)
+	 *
+	 * @param file_name The output file
+	 * @param query The start/end stored in the header
+	 * @return bool 'true' on success
+	 */
+	bool writeBinary(const string &file_name, const PathQueryPair &query) const;
+
+	/**
+	 * Function: writeQueries()
+	 * Use: Write a query set, one "startX,startY,endX,endY" line per query
+	 *
+	 * @param file_name The output file
+	 * @param queries The pairs to write
+	 * @return bool 'true' on success
+	 */
+	static bool writeQueries(const string &file_name, const vector<PathQueryPair> &queries);
+
+	/**
+	 * Function: parseTopology()
+	 * Use: Convert a topology name ("random", "maze", "rooms", "warehouse")
+	 *
+	 * @param name The topology name
+	 * @param topology The return topology
+	 * @return bool 'true' if the name is known
+	 */
+	static bool parseTopology(const string &name, MapTopology::Type &topology);
+
+	//---------------------------------------------------------------------
+	// Fetch functions
+	//---------------------------------------------------------------------
+	/**
+	 * Function: getBlocked()
+	 *
+	 * @param x The tile column
+	 * @param y The tile row
+	 * @return 'true' if the tile is an obstacle
+	 */
+	bool getBlocked(unsigned int x, unsigned int y) const
+	{
+		return (obstacle_words[y*row_words + x/MAP_WORD_BITS] >> (x%MAP_WORD_BITS)) & 1;
+	}
+	/**
+	 * Function: getObstacleWords()
+	 *
+	 * @param void
+	 * @return Row-major obstacle bits (bit set = obstacle), getRowWords() words per row
+	 */
+	const vector<uint64_t> &getObstacleWords() const { return obstacle_words; }
+	/**
+	 * Function: getRowWords()
+	 *
+	 * @param void
+	 * @return Number of obstacle words per map row
+	 */
+	unsigned int getRowWords() const { return row_words; }
+	/**
+	 * Function: getWidth()
+	 *
+	 * @param void
+	 * @return Width of the map
+	 */
+	unsigned int getWidth() const { return width; }
+	/**
+	 * Function: getHeight()
+	 *
+	 * @param void
+	 * @return Height of the map
+	 */
+	unsigned int getHeight() const { return height; }
+
+private:
+
+	// Map size
+	unsigned int width, height, row_words;
+
+	// Obstacle bits (bit set = obstacle)
+	vector<uint64_t> obstacle_words;
+
+	// Generator state (splitmix64, so sequences match across compilers/platforms)
+	unsigned long long rng_state;
+
+	/**
+	 * Function: nextRandom()
+	 *
+	 * @param void
+	 * @return A uniformly distributed 64-bit value
+	 */
+	unsigned long long nextRandom();
+
+	/**
+	 * Function: randomBelow()
+	 *
+	 * @param bound The exclusive upper bound (must be > 0)
+	 * @return A uniformly distributed value in [0, bound)
+	 */
+	unsigned int randomBelow(unsigned int bound);
+
+	/**
+	 * Function: fillRect()
+	 * Use: Set a rectangle of tiles (clipped to the map) to obstacle/traversable
+	 *
+	 * @param x0 Left column
+	 * @param y0 Top row
+	 * @param rect_width Rectangle width
+	 * @param rect_height Rectangle height
+	 * @param blocked 'true' for obstacle
+	 * @return void
+	 */
+	void fillRect(unsigned int x0, unsigned int y0, unsigned int rect_width, unsigned int rect_height, bool blocked);
+
+	/**
+	 * Function: generateRandom(), generateMaze(), generateRooms(), generateWarehouse()
+	 * Use: Build one topology (see MapTopology)
+	 */
+	void generateRandom(double density);
+	void generateMaze();
+	void generateRooms();
+	void generateWarehouse();
+};
+
+
+
+#endif /* MAPGENERATOR_HPP_ */
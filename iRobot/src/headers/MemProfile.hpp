@@ -0,0 +1,149 @@
+/**
+ * MemProfile.hpp
+ *  Created on: Oct 18, 2026
+ *      Author: iRobot maintainers
+ *     Purpose: Allocation and memory-footprint profiling (Includes.h MEM_PROFILE '1')
+ *              Counts heap bytes and allocations per subsystem (loader, map, search, output),
+ *              peak RSS per program phase, and Open list high-water marks per search engine,
+ *              and prints a report at exit
+ *              With MEM_PROFILE '0' every hook here is an empty inline, and operator new is untouched
+ */
+
+#ifndef MEMPROFILE_HPP_
+#define MEMPROFILE_HPP_
+
+#include "../headers/Includes.h"
+
+#include <cstdint>
+
+// Most phases / search engines the report keeps
+#define MEM_MAX_PHASES	32
+#define MEM_MAX_ENGINES	8
+
+// Subsystems heap allocations are charged to
+namespace MemSubsystem
+{
+	enum Type
+	{
+		MEM_OTHER,		// Anything outside a MemScope
+		MEM_LOADER,		// Map file reading and parsing
+		MEM_MAP,		// GameMap pages, clearance, preprocessing
+		MEM_SEARCH,		// Search state (planes, Open lists, paths)
+		MEM_OUTPUT,		// Path formatting and writing
+		NUM_SUBSYSTEMS // DO NOT ADD BELOW THIS
+	} ;
+}
+
+#if MEM_PROFILE
+
+// Charges the current thread's heap allocations to a subsystem while in scope (scopes nest)
+class MemScope
+{
+public:
+	/**
+	 * Function: MemScope(MemSubsystem::Type subsystem)
+	 * Use: Start charging this thread's allocations to 'subsystem'
+	 *
+	 * @param subsystem The subsystem
+	 */
+	MemScope(MemSubsystem::Type subsystem);
+
+	/**
+	 * Function: ~MemScope()
+	 * Use: Go back to the enclosing scope's subsystem
+	 *
+	 * @param void
+	 */
+	~MemScope();
+
+private:
+	MemSubsystem::Type prev_subsystem;
+};
+
+// Measures one program phase, from construction to end() (or destruction):
+// peak and final RSS, and heap allocations
+class MemPhase
+{
+public:
+	/**
+	 * Function: MemPhase(const char *phase_name_arg)
+	 * Use: Start a phase (resets the kernel's peak RSS counter, where Linux allows it)
+	 *
+	 * @param phase_name_arg The phase name (must be a string literal, or outlive the report)
+	 */
+	MemPhase(const char *phase_name_arg);
+
+	/**
+	 * Function: ~MemPhase()
+	 * Use: Ends the phase, if end() wasn't called
+	 *
+	 * @param void
+	 */
+	~MemPhase();
+
+	/**
+	 * Function: end()
+	 * Use: Record the phase for the report (only the first call counts)
+	 *
+	 * @param void
+	 * @return void
+	 */
+	void end();
+
+private:
+	const char *phase_name;
+	uint64_t begin_count, begin_bytes;
+	bool ended;
+};
+
+/**
+ * Function: memRecordOpenList()
+ * Use: Record the largest Open list size one search reached
+ *
+ * @param engine_name The search engine (must be a string literal)
+ * @param high_water The search's largest Open list size (entries)
+ * @param entry_bytes The size of one Open list entry
+ * @return void
+ */
+void memRecordOpenList(const char *engine_name, size_t high_water, size_t entry_bytes);
+
+/**
+ * Function: memGetAllocCount()
+ *
+ * @param subsystem The subsystem
+ * @return uint64_t Number of heap allocations charged to 'subsystem' so far
+ */
+uint64_t memGetAllocCount(MemSubsystem::Type subsystem);
+
+/**
+ * Function: memPrintReport()
+ * Use: Print the report (runs automatically at exit)
+ *
+ * @param void
+ * @return void
+ */
+void memPrintReport();
+
+#else
+
+// Profiling is off: the hooks compile away
+class MemScope
+{
+public:
+	MemScope(MemSubsystem::Type) {}
+};
+
+class MemPhase
+{
+public:
+	MemPhase(const char *) {}
+	void end() {}
+};
+
+inline void memRecordOpenList(const char *, size_t, size_t) {}
+inline uint64_t memGetAllocCount(MemSubsystem::Type) { return 0; }
+inline void memPrintReport() {}
+
+#endif
+
+#endif /* MEMPROFILE_HPP_ */
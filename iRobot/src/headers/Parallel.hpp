@@ -0,0 +1,58 @@
+/**
+ * Parallel.hpp
+ *  Created on: Oct 18, 2026
+ *      Author: iRobot maintainers
+ *     Purpose: Minimal fork/join helper for splitting bulk grid passes across threads
+ */
+
+#ifndef PARALLEL_HPP_
+#define PARALLEL_HPP_
+
+#include "../headers/Includes.h"
+
+#include <thread>
+#include <functional>
+
+/**
+ * Function: getNumWorkers()
+ * Use: Number of threads to use for bulk passes (at least 1)
+ *
+ * @param void
+ * @return unsigned int The worker count
+ */
+inline unsigned int getNumWorkers()
+{
+	unsigned int num_workers = std::thread::hardware_concurrency();
+	return (num_workers == 0) ? 1 : num_workers;
+}
+
+/**
+ * Function: parallelFor()
+ * Use: Split [0, num_items) into one contiguous block per worker, and run 'body' on
+ *      each block concurrently. Returns when every block is finished
+ *      Runs inline (no threads) when there is only one worker or one item
+ *
+ * @param num_items The number of items (rows, columns, obstacles...) to process
+ * @param body Called as body(begin, end) for each block
+ * @return void
+ */
+inline void parallelFor(unsigned int num_items, const std::function<void(unsigned int, unsigned int)> &body)
+{
+	unsigned int num_workers = std::min(getNumWorkers(), num_items);
+	if(num_workers <= 1)
+	{
+		if(num_items > 0)
+			body(0, num_items);
+		return;
+	}
+
+	std::vector<std::thread> workers;
+	unsigned int block_size = (num_items + num_workers - 1) / num_workers;
+	for(unsigned int begin = 0; begin < num_items; begin += block_size)
+		workers.push_back(std::thread(body, begin, std::min(begin + block_size, num_items)));
+
+	for(unsigned int worker_idx = 0; worker_idx < workers.size(); ++worker_idx)
+		workers[worker_idx].join();
+}
+
+#endif /* PARALLEL_HPP_ */
@@ -0,0 +1,268 @@
+/**
+ * PathCache.hpp
+ *  Created on: Oct 18, 2026
+ *      Author: iRobot maintainers
+ *     Purpose: LRU cache of finished A* results, bounded by memory
+ *              Entries are keyed by (start, end, robot radius), and are all valid for
+ *              one map version, which obstacle updates move forward
+ *              A coarse spatial index over the cached paths lets an obstacle update
+ *              invalidate only the entries it actually affects
+ */
+
+#ifndef PATHCACHE_HPP_
+#define PATHCACHE_HPP_
+
+#include "../headers/Includes.h"
+#include "../headers/GameMap.hpp"
+#include "../headers/SearchArena.hpp"
+
+#include <list>
+#include <memory>
+#include <unordered_map>
+#include <unordered_set>
+
+// Width/height (in tiles) of one spatial index cell
+#define CACHE_CELL_SIZE	16
+
+using namespace std;
+
+// Lookup key for a cached path
+struct PathQuery
+{
+	PosTile start, end;
+	float robot_radius;
+
+	bool operator ==(const PathQuery &other) const
+	{
+		return start.x == other.start.x && start.y == other.start.y &&
+		       end.x == other.end.x && end.y == other.end.y &&
+		       robot_radius == other.robot_radius;
+	}
+};
+
+// Hash definition for PathQuery
+struct PathQueryHash
+{
+	size_t operator ()(const PathQuery &query) const
+	{
+		size_t hash = query.start.x;
+		hash = hash*31 + query.start.y;
+		hash = hash*31 + query.end.x;
+		hash = hash*31 + query.end.y;
+		hash = hash*31 + std::hash<float>()(query.robot_radius);
+		return hash;
+	}
+};
+
+// Counters for the cache (all counts since construction)
+struct PathCacheStats
+{
+	unsigned long hits,				// Lookups answered from the cache
+	              misses,			// Lookups that had to run A*
+	              evictions,		// Entries dropped to stay under the memory bound
+	              invalidations;	// Entries dropped by obstacle updates (or an unannounced map change)
+	size_t bytes_used;				// Current (estimated) memory footprint of the entries
+
+	double getHitRate() const
+	{
+		unsigned long lookups = hits + misses;
+		return (lookups == 0) ? 0.0 : (double)hits / lookups;
+	}
+};
+
+class PathCache
+{
+public:
+	//---------------------------------------------------------------------
+	// Constructors/Destructor
+	//---------------------------------------------------------------------
+	/**
+	 * Function: PathCache(size_t max_bytes_arg)
+	 * Use: Initialization constructor
+	 *
+	 * @param max_bytes_arg The memory bound for cached entries (paths, index, bookkeeping)
+	 */
+	PathCache(size_t max_bytes_arg);
+
+	/**
+	 * Function: ~PathCache()
+	 * Use: Destructor
+	 *
+	 * @param void
+	 */
+	~PathCache();
+
+	/**
+	 * Function: findPath()
+	 * Use: Return the path from 'start' to 'end', from the cache if possible
+	 *      On a miss, runs A* to completion and caches the result
+	 *      The search state lives in the cache's SearchArena, reused by every miss
+	 *
+	 * @param game_map The traversability map
+	 * @param start The start [x,y] tile
+	 * @param end The end [x,y] tile
+	 * @param robot_radius The robot radius (see GameMap::isPassable())
+	 * @param path The return path (start to end, empty if there is no path). Shared with the cache
+	 * @return bool 'true' if a path exists
+	 */
+	bool findPath(const GameMap &game_map, const PosTile &start, const PosTile &end, float robot_radius,
+	              shared_ptr<const vector<PosTile> > &path);
+
+	/**
+	 * Function: lookup()
+	 * Use: Fetch a cached result, and mark it most-recently-used
+	 *      Counts as a hit or miss (always a miss if the cache holds another map version)
+	 *
+	 * @param map_version The version of the map being searched (GameMap::getVersion())
+	 * @param query The lookup key
+	 * @param path The return path (empty if the cached result is "no path")
+	 * @return bool 'true' if the query was in the cache
+	 */
+	bool lookup(unsigned long map_version, const PathQuery &query, shared_ptr<const vector<PosTile> > &path);
+
+	/**
+	 * Function: insert()
+	 * Use: Add a result to the cache, evicting least-recently-used entries to make room
+	 *      Results larger than the whole memory bound are not cached
+	 *      A result for another map version than the cache holds first drops every entry
+	 *      (the cache wasn't told what changed, see onObstacleUpdate())
+	 *
+	 * @param map_version The version of the map the result was found on
+	 * @param query The lookup key
+	 * @param path The path for the query (empty for "no path")
+	 * @return void
+	 */
+	void insert(unsigned long map_version, const PathQuery &query, const shared_ptr<const vector<PosTile> > &path);
+
+	/**
+	 * Function: onObstacleUpdate()
+	 * Use: Carry the cache over an obstacle update (GameMap::updateObstacles()) of map
+	 *      'old_version' to 'new_version'
+	 *      New obstacles invalidate only the paths passing within robot radius of them
+	 *      Cleared obstacles invalidate only cached "no path" results (cached paths stay
+	 *      collision-free, although a shorter path may now exist)
+	 *      The other entries carry over to 'new_version' without being touched, so the
+	 *      work is proportional to the update, not to the cache size
+	 *      If the cache doesn't hold 'old_version' (it missed an update), every entry is dropped
+	 *
+	 * @param old_version The map version before the update
+	 * @param new_version The map version after the update
+	 * @param tiles The tiles that were changed
+	 * @param traversable The new traversability of the tiles
+	 * @return void
+	 */
+	void onObstacleUpdate(unsigned long old_version, unsigned long new_version,
+	                      const vector<PosTile> &tiles, bool traversable);
+
+	/**
+	 * Function: clear()
+	 * Use: Drop every entry (counters are kept)
+	 *
+	 * @param void
+	 * @return void
+	 */
+	void clear();
+
+	//---------------------------------------------------------------------
+	// Fetch functions
+	//---------------------------------------------------------------------
+	/**
+	 * Function: getStats()
+	 *
+	 * @param void
+	 * @return PathCacheStats The cache counters
+	 */
+	PathCacheStats getStats() const { return stats; }
+	/**
+	 * Function: getNumEntries()
+	 *
+	 * @param void
+	 * @return size_t Number of cached results
+	 */
+	size_t getNumEntries() const { return lru_list.size(); }
+
+	/**
+	 * Function: printStats()
+	 * Use: Prints the hit/miss/eviction/invalidation counters
+	 *
+	 * @param out The stream to print to
+	 * @return void
+	 */
+	void printStats(ostream &out) const;
+
+private:
+
+	// One cached result
+	struct CacheEntry
+	{
+		PathQuery query;
+		shared_ptr<const vector<PosTile> > path;
+		vector<unsigned long> cells;	// Spatial index cells the path passes through
+		size_t bytes;					// Estimated footprint of this entry
+	};
+	typedef list<CacheEntry>::iterator EntryIt;
+
+	// Entries in most-recently-used-first order
+	list<CacheEntry> lru_list;
+
+	// Key -> entry lookup
+	unordered_map<PathQuery, EntryIt, PathQueryHash> entries;
+
+	// Spatial index: cell -> entries whose path passes through the cell
+	unordered_map<unsigned long, unordered_set<CacheEntry *> > cell_index;
+
+	// Cached "no path" results (they're affected by any cleared obstacle)
+	unordered_set<CacheEntry *> unreachable_entries;
+
+	// Map version every entry is valid for (0 until the first insert)
+	unsigned long cache_version;
+
+	// Largest robot radius of any entry (bounds the index search around updated tiles)
+	float max_radius;
+
+	// Memory bound and counters
+	size_t max_bytes;
+	PathCacheStats stats;
+
+	// Search state for misses (not counted against max_bytes: it's as big as one search)
+	SearchArena search_arena;
+
+	/**
+	 * Function: getCellId()
+	 *
+	 * @param x The tile column
+	 * @param y The tile row
+	 * @return unsigned long The id of the spatial index cell containing the tile
+	 */
+	static unsigned long getCellId(unsigned int x, unsigned int y)
+	{
+		return ((unsigned long)(y / CACHE_CELL_SIZE) << 32) | (x / CACHE_CELL_SIZE);
+	}
+
+	/**
+	 * Function: removeEntry()
+	 * Use: Drop an entry from the LRU list, key lookup, and spatial index
+	 *
+	 * @param entry_it The entry to drop
+	 * @return void
+	 */
+	void removeEntry(EntryIt entry_it);
+
+	/**
+	 * Function: pathNearTiles()
+	 * Use: Check whether any tile of a cached path is within its robot radius of one of
+	 *      'tiles' (i.e. whether obstacles at 'tiles' would block the path)
+	 *
+	 * @param entry The cached entry
+	 * @param tiles The updated tiles
+	 * @param low The smallest x and y of the updated tiles
+	 * @param high The largest x and y of the updated tiles
+	 * @return bool 'true' if the path is affected
+	 */
+	static bool pathNearTiles(const CacheEntry &entry, const vector<PosTile> &tiles, const PosTile &low,
+	                          const PosTile &high);
+};
+
+
+
+#endif /* PATHCACHE_HPP_ */
@@ -0,0 +1,158 @@
+/**
+ * PathWriter.hpp
+ *  Created on: Oct 18, 2026
+ *      Author: iRobot maintainers
+ *     Purpose: Formats paths into a reusable, preallocated output buffer
+ *              Supports the plain "x,y" text format, turn-point waypoints only, and a binary format
+ *              See README.txt for the binary layout
+ */
+
+#ifndef PATHWRITER_HPP_
+#define PATHWRITER_HPP_
+
+#include "../headers/Includes.h"
+
+#include <charconv>
+#include <cstdint>
+
+// Magic number at the start of a binary path ("IRPB", little-endian)
+#define PATH_BINARY_MAGIC	0x42505249u
+
+// Longest "x,y\n" line for 32-bit coordinates
+#define PATH_MAX_LINE_CHARS	22
+
+using namespace std;
+
+// Output formats for paths
+namespace PathFormat
+{
+	enum Type
+	{
+		FORMAT_TEXT,	// One "x,y" line per tile
+		FORMAT_BINARY,	// Header followed by packed 32-bit (x,y) pairs
+		NUM_FORMATS // DO NOT ADD BELOW THIS
+	} ;
+}
+
+class PathWriter
+{
+public:
+	//---------------------------------------------------------------------
+	// Constructors/Destructor
+	//---------------------------------------------------------------------
+	/**
+	 * Function: PathWriter(size_t initial_capacity)
+	 * Use: Initialization constructor
+	 *      Preallocates the output buffer (it grows if a path needs more)
+	 *
+	 * @param initial_capacity The starting size of the output buffer (bytes)
+	 */
+	PathWriter(size_t initial_capacity);
+
+	/**
+	 * Function: ~PathWriter()
+	 * Use: Destructor
+	 *
+	 * @param void
+	 */
+	~PathWriter();
+
+	/**
+	 * Function: clear()
+	 * Use: Empty the buffer (keeps the allocation for reuse)
+	 *
+	 * @param void
+	 * @return void
+	 */
+	void clear() { buffer_size = 0; }
+
+	/**
+	 * Function: appendText()
+	 * Use: Append raw text (e.g. a header line) to the buffer
+	 *
+	 * @param text The text to append
+	 * @return void
+	 */
+	void appendText(const string &text);
+
+	/**
+	 * Function: appendPath()
+	 * Use: Append a path to the buffer in the given format
+	 *      If 'waypoints_only', only the start, the end, and the tiles where the
+	 *      movement direction changes are written (straight runs are dropped)
+	 *
+	 * @param path The tile positions from start to end
+	 * @param format The output format
+	 * @param waypoints_only Write turn points only
+	 * @return void
+	 */
+	void appendPath(const vector<PosTile> &path, PathFormat::Type format, bool waypoints_only);
+
+	/**
+	 * Function: writeTo()
+	 * Use: Write the whole buffer to a stream in one call
+	 *
+	 * @param out The stream to write to
+	 * @return void
+	 */
+	void writeTo(ostream &out) const { out.write(&buffer[0], buffer_size); }
+
+	//---------------------------------------------------------------------
+	// Fetch functions
+	//---------------------------------------------------------------------
+	/**
+	 * Function: getData()
+	 *
+	 * @param void
+	 * @return const char* The formatted bytes
+	 */
+	const char *getData() const { return &buffer[0]; }
+	/**
+	 * Function: getSize()
+	 *
+	 * @param void
+	 * @return size_t The number of formatted bytes
+	 */
+	size_t getSize() const { return buffer_size; }
+
+	/**
+	 * Function: getWaypoints()
+	 * Use: Run-length compress a path to its turn points (start, direction changes, end)
+	 *
+	 * @param path The tile positions from start to end
+	 * @param waypoints The return turn points
+	 * @return void
+	 */
+	static void getWaypoints(const vector<PosTile> &path, vector<PosTile> &waypoints);
+
+private:
+
+	// The output buffer, and the number of bytes used in it
+	vector<char> buffer;
+	size_t buffer_size;
+
+	// Scratch space for waypoint compression (kept for reuse)
+	vector<PosTile> waypoints;
+
+	/**
+	 * Function: reserve()
+	 * Use: Make sure there is room for 'num_bytes' more bytes
+	 *
+	 * @param num_bytes The number of bytes about to be written
+	 * @return char* Where to write them
+	 */
+	char *reserve(size_t num_bytes);
+
+	/**
+	 * Function: appendUInt32()
+	 * Use: Append a little-endian 32-bit value (binary format)
+	 *
+	 * @param value The value to append
+	 * @return void
+	 */
+	void appendUInt32(uint32_t value);
+};
+
+
+
+#endif /* PATHWRITER_HPP_ */
@@ -0,0 +1,136 @@
+/**
+ * SearchArena.hpp
+ *  Created on: Oct 18, 2026
+ *      Author: iRobot maintainers
+ *     Purpose: Bump allocator for per-query search state (AStar planes and Open list)
+ *              Allocation moves a pointer along a block; freeing does nothing, and reset()
+ *              takes everything back at once. After a reset the arena is one block as big as
+ *              all of the last query's blocks together, so once the arena has seen the largest
+ *              query a search makes no heap allocations at all
+ */
+
+#ifndef SEARCHARENA_HPP_
+#define SEARCHARENA_HPP_
+
+#include "../headers/Includes.h"
+
+#include <memory_resource>
+
+// Smallest block the arena asks the heap for
+#define ARENA_MIN_BLOCK_BYTES	(64*1024)
+
+using namespace std;
+
+class SearchArena : public pmr::memory_resource
+{
+public:
+	//---------------------------------------------------------------------
+	// Constructors/Destructor
+	//---------------------------------------------------------------------
+	/**
+	 * Function: SearchArena(size_t initial_bytes)
+	 * Use: Initialization constructor
+	 *
+	 * @param initial_bytes The size of the first block (0 to allocate it on first use)
+	 */
+	SearchArena(size_t initial_bytes = 0);
+
+	/**
+	 * Function: ~SearchArena()
+	 * Use: Destructor
+	 *      Frees every block, so nothing allocated from the arena may outlive it
+	 *
+	 * @param void
+	 */
+	~SearchArena();
+
+	/**
+	 * Function: reset()
+	 * Use: Take back every allocation (the containers using the arena must be gone)
+	 *      If the last query needed more than one block, they're merged into one
+	 *
+	 * @param void
+	 * @return void
+	 */
+	void reset();
+
+	//---------------------------------------------------------------------
+	// Fetch functions
+	//---------------------------------------------------------------------
+	/**
+	 * Function: getCapacity()
+	 *
+	 * @param void
+	 * @return size_t Total bytes of the arena's blocks
+	 */
+	size_t getCapacity() const { return capacity; }
+	/**
+	 * Function: getUsed()
+	 *
+	 * @param void
+	 * @return size_t Bytes handed out since the last reset()
+	 */
+	size_t getUsed() const { return used; }
+	/**
+	 * Function: getPeak()
+	 *
+	 * @param void
+	 * @return size_t Largest getUsed() between two resets
+	 */
+	size_t getPeak() const { return peak; }
+	/**
+	 * Function: getNumHeapAllocs()
+	 *
+	 * @param void
+	 * @return unsigned long Number of blocks the arena has asked the heap for
+	 */
+	unsigned long getNumHeapAllocs() const { return num_heap_allocs; }
+
+private:
+
+	// Header at the start of each block (blocks form a list, newest first)
+	struct Block
+	{
+		Block *next;
+		size_t size;	// Including this header
+	};
+
+	// The block being allocated from, and its free range
+	Block *head;
+	char *cur, *end;
+
+	// Counters
+	size_t capacity, used, peak;
+	unsigned long num_heap_allocs;
+
+	// No copying (allocations point into the blocks)
+	SearchArena(const SearchArena &);
+	SearchArena &operator =(const SearchArena &);
+
+	/**
+	 * Function: addBlock()
+	 * Use: Get a new block from the heap, big enough for 'min_bytes'
+	 *
+	 * @param min_bytes The usable size needed
+	 * @return void
+	 */
+	void addBlock(size_t min_bytes);
+
+	/**
+	 * Function: freeBlocks()
+	 * Use: Return every block to the heap
+	 *
+	 * @param void
+	 * @return void
+	 */
+	void freeBlocks();
+
+	// pmr::memory_resource interface
+	void *do_allocate(size_t bytes, size_t alignment) override;
+	void do_deallocate(void *ptr, size_t bytes, size_t alignment) override;
+	bool do_is_equal(const pmr::memory_resource &other) const noexcept override { return this == &other; }
+};
+
+
+
+#endif /* SEARCHARENA_HPP_ */
@@ -0,0 +1,102 @@
+/**
+ * SearchScheduler.hpp
+ *  Created on: Oct 18, 2026
+ *      Author: iRobot maintainers
+ *     Purpose: Shares one thread between many resumable A* searches
+ *              Each search is advanced by a fixed quantum in round-robin order, so that a
+ *              control loop can bound the time it spends pathfinding per tick
+ */
+
+#ifndef SEARCHSCHEDULER_HPP_
+#define SEARCHSCHEDULER_HPP_
+
+#include "../headers/Includes.h"
+#include "../headers/AStar.hpp"
+
+using namespace std;
+
+class SearchScheduler
+{
+public:
+	//---------------------------------------------------------------------
+	// Constructors/Destructor
+	//---------------------------------------------------------------------
+	/**
+	 * Function: SearchScheduler(unsigned long quantum_arg)
+	 * Use: Initialization constructor
+	 *
+	 * @param quantum_arg The number of expansions each search runs before yielding
+	 */
+	SearchScheduler(unsigned long quantum_arg);
+
+	/**
+	 * Function: ~SearchScheduler()
+	 * Use: Destructor
+	 *      Does not delete the searches (they are owned by the caller)
+	 *
+	 * @param void
+	 */
+	~SearchScheduler();
+
+	/**
+	 * Function: addSearch()
+	 * Use: Add a search to the round-robin
+	 *      The search must stay alive until it finishes or is removed
+	 *
+	 * @param search The search to run
+	 * @return void
+	 */
+	void addSearch(AStar *search);
+
+	/**
+	 * Function: removeSearch()
+	 * Use: Remove a search from the round-robin (e.g. after cancelling it)
+	 *
+	 * @param search The search to remove
+	 * @return void
+	 */
+	void removeSearch(AStar *search);
+
+	/**
+	 * Function: runSlice()
+	 * Use: Advance every active search by one quantum
+	 *      Finished (found/unreachable/cancelled) searches are dropped
+	 *
+	 * @param void
+	 * @return unsigned int The number of searches still running
+	 */
+	unsigned int runSlice();
+
+	/**
+	 * Function: runUntil()
+	 * Use: Advance the active searches in round-robin until all finish or 'deadline' passes
+	 *      The deadline may be overrun by up to one quantum of one search
+	 *
+	 * @param deadline The (steady clock) time at which to return control
+	 * @return unsigned int The number of searches still running
+	 */
+	unsigned int runUntil(const chrono::steady_clock::time_point &deadline);
+
+	//---------------------------------------------------------------------
+	// Fetch functions
+	//---------------------------------------------------------------------
+	/**
+	 * Function: getNumActive()
+	 *
+	 * @param void
+	 * @return unsigned int The number of searches still running
+	 */
+	unsigned int getNumActive() const { return active_searches.size(); }
+
+private:
+
+	// Searches still running, in round-robin order
+	deque<AStar *> active_searches;
+
+	// Number of expansions per search per turn
+	unsigned long quantum;
+};
+
+
+
+#endif /* SEARCHSCHEDULER_HPP_ */
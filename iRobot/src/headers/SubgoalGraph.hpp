@@ -0,0 +1,292 @@
+/**
+ * SubgoalGraph.hpp
+ *  Created on: Oct 18, 2026
+ *      Author: iRobot maintainers
+ *     Purpose: Preprocessed pathfinding for static maps (Simple Subgoal Graphs)
+ *              Subgoals are placed at convex obstacle corners, and two subgoals are joined
+ *              when one can reach the other along an obstacle-free octile route (diagonal
+ *              steps, then straight steps)
+ *              A query links start/goal to the graph, searches the small graph, and expands
+ *              the result back into tiles
+ *              Routes never cut obstacle corners (a diagonal step needs both side tiles free),
+ *              unlike AStar's, so every path is also a valid AStar path, but it can be much
+ *              longer on maze-like maps (see PATH_ENGINE_SUBGOAL in Includes.h)
+ *              See README.txt for the side file format
+ */
+
+#ifndef SUBGOALGRAPH_HPP_
+#define SUBGOALGRAPH_HPP_
+
+#include "../headers/Includes.h"
+#include "../headers/GameMap.hpp"
+
+#include <cstdint>
+
+// Magic number at the start of a subgoal graph file ("IRSG", little-endian)
+#define SUBGOAL_MAGIC	0x47535249u
+#define SUBGOAL_VERSION	2
+
+// Node value for "none"
+#define NO_NODE	0xFFFFFFFFu
+
+// Cost of one diagonal move (same as AStar)
+#define SUBGOAL_DIAG_COST	1.4f
+
+using namespace std;
+
+// Edge used while building the graph
+struct SubgoalEdge
+{
+	uint32_t target;
+	float cost;
+};
+
+class SubgoalGraph
+{
+public:
+	//---------------------------------------------------------------------
+	// Constructors/Destructor
+	//---------------------------------------------------------------------
+	/**
+	 * Function: SubgoalGraph()
+	 * Use: Creates an empty graph. Call build() or load() before findPath()
+	 *
+	 * @param void
+	 */
+	SubgoalGraph();
+
+	/**
+	 * Function: ~SubgoalGraph()
+	 * Use: Destructor
+	 *
+	 * @param void
+	 */
+	~SubgoalGraph();
+
+	/**
+	 * Function: build()
+	 * Use: Preprocess a map: place the subgoals, and join the directly reachable pairs
+	 *      Takes seconds on large maps, so save() the result
+	 *
+	 * @param game_map The traversability map (must outlive the graph, and not change)
+	 * @return void
+	 */
+	void build(const GameMap &game_map);
+
+	/**
+	 * Function: save()
+	 * Use: Write the graph to a side file (see README.txt)
+	 *
+	 * @param file_name The output file
+	 * @return bool 'true' on success
+	 */
+	bool save(const string &file_name) const;
+
+	/**
+	 * Function: load()
+	 * Use: Read a graph written by save()
+	 *      Fails if the file was built from a different map (size or obstacles)
+	 *
+	 * @param file_name The side file
+	 * @param game_map The traversability map (must outlive the graph, and not change)
+	 * @return bool 'true' on success
+	 */
+	bool load(const string &file_name, const GameMap &game_map);
+
+	/**
+	 * Function: loadOrBuild()
+	 * Use: load() the side file, or build() and save() it if it is missing or stale
+	 *
+	 * @param file_name The side file
+	 * @param game_map The traversability map (must outlive the graph, and not change)
+	 * @return bool 'true' if the graph was loaded, 'false' if it was built
+	 */
+	bool loadOrBuild(const string &file_name, const GameMap &game_map);
+
+	/**
+	 * Function: findPath()
+	 * Use: Find a path from start to goal with the graph
+	 *      Reuses per-query scratch space, so one graph can't answer queries on several threads
+	 *
+	 * @param start The start [x,y] tile
+	 * @param goal The goal [x,y] tile
+	 * @param path The return tiles, start to goal (one tile per move)
+	 * @return bool 'true' if a path was found
+	 *              'false' if there is none without cutting corners (AStar may still find one)
+	 */
+	bool findPath(const PosTile &start, const PosTile &goal, vector<PosTile> &path);
+
+	/**
+	 * Function: getSideFileName()
+	 *
+	 * @param map_file_name The map file
+	 * @return string The side file the graph for that map is saved to
+	 */
+	static string getSideFileName(const string &map_file_name) { return map_file_name + ".sgr"; }
+
+	/**
+	 * Function: calcChecksum()
+	 *
+	 * @param game_map The traversability map
+	 * @return uint64_t Hash of the map size and obstacles (detects stale side files)
+	 */
+	static uint64_t calcChecksum(const GameMap &game_map);
+
+	//---------------------------------------------------------------------
+	// Fetch functions
+	//---------------------------------------------------------------------
+	/**
+	 * Function: getNumNodes()
+	 *
+	 * @param void
+	 * @return unsigned int The number of subgoals
+	 */
+	unsigned int getNumNodes() const { return subgoal_tiles.size(); }
+	/**
+	 * Function: getNumEdges()
+	 *
+	 * @param void
+	 * @return size_t The number of stored edges (both directions)
+	 */
+	size_t getNumEdges() const { return edge_targets.size(); }
+	/**
+	 * Function: getPathCost()
+	 *
+	 * @param void
+	 * @return float The cost of the last path found (1 per straight move, SUBGOAL_DIAG_COST per diagonal)
+	 */
+	float getPathCost() const { return path_cost; }
+
+private:
+
+	// Per-node search state. 'stamp' tells which query wrote it, so a query only
+	// resets the nodes it touches
+	struct SearchLabel
+	{
+		float dist;
+		uint32_t parent;	// Previous node (NO_NODE at the search root)
+		uint32_t stamp;
+	};
+
+	// The map the graph was built for
+	const GameMap *game_map_ptr;
+	unsigned int map_width, map_height;
+	uint64_t map_checksum;
+
+	// Subgoal tiles (row-major tile index, sorted), and one bit per tile marking them
+	vector<uint32_t> subgoal_tiles;
+	vector<uint64_t> subgoal_bits;
+
+	// Edges in compressed rows: node n's edges are [edge_offsets[n], edge_offsets[n+1])
+	vector<uint32_t> edge_offsets, edge_targets;
+	vector<float> edge_costs;
+
+	// Query scratch space (nodes 0..N-1 are subgoals, N is the start, N+1 is the goal)
+	vector<SearchLabel> fwd_labels, bwd_labels;
+	uint32_t query_stamp;
+	float path_cost;
+
+	/**
+	 * Function: canMove()
+	 *
+	 * @param x The tile column
+	 * @param y The tile row
+	 * @param dx The column step (-1, 0, 1)
+	 * @param dy The row step (-1, 0, 1)
+	 * @return bool 'true' if the move stays on the map, ends on a free tile,
+	 *              and (if diagonal) doesn't cut an obstacle corner
+	 */
+	bool canMove(int x, int y, int dx, int dy) const;
+
+	/**
+	 * Function: isSubgoal()
+	 *
+	 * @param tile The row-major tile index
+	 * @return bool 'true' if the tile is a subgoal
+	 */
+	bool isSubgoal(uint32_t tile) const { return (subgoal_bits[tile/64] >> (tile%64)) & 1; }
+
+	/**
+	 * Function: findNode()
+	 *
+	 * @param tile The row-major tile index
+	 * @return uint32_t The node of a subgoal tile (NO_NODE if it isn't one)
+	 */
+	uint32_t findNode(uint32_t tile) const;
+
+	/**
+	 * Function: scanClearance()
+	 * Use: Count the moves from (x,y) in one direction before an obstacle, a subgoal
+	 *      or 'extra_target' is reached
+	 *
+	 * @param x The tile column
+	 * @param y The tile row
+	 * @param dx The column step
+	 * @param dy The row step
+	 * @param extra_target A tile treated as a subgoal (NO_NODE for none)
+	 * @param hit_target The return flag, 'true' if the scan stopped at a subgoal/'extra_target'
+	 * @return unsigned int The number of moves
+	 */
+	unsigned int scanClearance(int x, int y, int dx, int dy, uint32_t extra_target, bool &hit_target) const;
+
+	/**
+	 * Function: findReachable()
+	 * Use: Find the subgoals (and 'extra_target') directly reachable from a tile: those the
+	 *      clearance scans reach by diagonal steps then straight steps, without passing another subgoal
+	 *
+	 * @param tile The row-major tile index to scan from
+	 * @param extra_target A tile treated as a subgoal (NO_NODE for none)
+	 * @param found The return (tile, cost) pairs
+	 * @return void
+	 */
+	void findReachable(uint32_t tile, uint32_t extra_target, vector< pair<uint32_t, float> > &found) const;
+
+	/**
+	 * Function: buildRows()
+	 * Use: Pack per-node edge lists into the compressed rows
+	 *
+	 * @param adjacency Each node's edges
+	 * @return void
+	 */
+	void buildRows(const vector< vector<SubgoalEdge> > &adjacency);
+
+	/**
+	 * Function: linkEndpoint()
+	 * Use: Find the graph nodes a query start/goal connects to
+	 *
+	 * @param tile The start/goal tile
+	 * @param other_tile The goal/start tile (linked directly if reachable)
+	 * @param links The return (node, cost) pairs (node N+1/N for 'other_tile')
+	 * @param other_node The node number used for 'other_tile'
+	 * @return void
+	 */
+	void linkEndpoint(uint32_t tile, uint32_t other_tile, uint32_t other_node,
+	                  vector< pair<uint32_t, float> > &links) const;
+
+	/**
+	 * Function: searchFlat()
+	 * Use: A* over the graph, octile distance heuristic
+	 *
+	 * @param start_links The start's (node, cost) links
+	 * @param goal_links The goal's (node, cost) links
+	 * @param goal The goal tile
+	 * @return bool 'true' if the goal was reached (follow fwd_labels back from node N+1)
+	 */
+	bool searchFlat(const vector< pair<uint32_t, float> > &start_links,
+	                const vector< pair<uint32_t, float> > &goal_links, const PosTile &goal);
+
+	/**
+	 * Function: appendSegment()
+	 * Use: Append the tiles between two directly reachable tiles (excluding 'from_tile')
+	 *
+	 * @param from_tile The row-major start tile
+	 * @param to_tile The row-major end tile
+	 * @param path The path to append to
+	 * @return bool 'true' if an obstacle-free octile route was found
+	 */
+	bool appendSegment(uint32_t from_tile, uint32_t to_tile, vector<PosTile> &path) const;
+};
+
+
+
+#endif /* SUBGOALGRAPH_HPP_ */
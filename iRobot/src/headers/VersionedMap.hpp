@@ -0,0 +1,96 @@
+/**
+ * VersionedMap.hpp
+ *  Created on: Oct 18, 2026
+ *      Author: iRobot maintainers
+ *     Purpose: Publishes immutable, versioned GameMap snapshots so searches can run while
+ *              obstacles are updated
+ *              Readers take the current snapshot once and then read it without any locking;
+ *              writers build the next version copy-on-write (only changed pages are new, see
+ *              MapPage) and publish it atomically. A version is freed when its last holder
+ *              lets go of it (reference counted)
+ */
+
+#ifndef VERSIONEDMAP_HPP_
+#define VERSIONEDMAP_HPP_
+
+#include "../headers/Includes.h"
+#include "../headers/GameMap.hpp"
+
+#include <memory>
+#include <mutex>
+
+using namespace std;
+
+class VersionedMap
+{
+public:
+	//---------------------------------------------------------------------
+	// Constructors/Destructor
+	//---------------------------------------------------------------------
+	/**
+	 * Function: VersionedMap(const GameMap &initial_map)
+	 * Use: Initialization constructor
+	 *      Publishes a copy of 'initial_map' (it shares the map's pages) as the first version
+	 *
+	 * @param initial_map The starting map
+	 */
+	VersionedMap(const GameMap &initial_map);
+
+	/**
+	 * Function: ~VersionedMap()
+	 * Use: Destructor
+	 *      Snapshots still held by readers stay valid
+	 *
+	 * @param void
+	 */
+	~VersionedMap();
+
+	/**
+	 * Function: acquire()
+	 * Use: Fetch the current snapshot (safe from any thread)
+	 *      The snapshot never changes, and stays alive while the caller holds it,
+	 *      however many versions are published meanwhile
+	 *
+	 * @param void
+	 * @return shared_ptr<const GameMap> The current map
+	 */
+	shared_ptr<const GameMap> acquire() const { return atomic_load(&current); }
+
+	/**
+	 * Function: updateObstacles()
+	 * Use: Publish a new version with a batch of tiles set to traversable/obstacle
+	 *      (see GameMap::updateObstacles()). Writers are serialised; readers are never blocked
+	 *
+	 * @param tiles The tiles to change
+	 * @param traversable The new traversability of the tiles
+	 * @return shared_ptr<const GameMap> The published map
+	 */
+	shared_ptr<const GameMap> updateObstacles(const vector<PosTile> &tiles, bool traversable);
+
+	/**
+	 * Function: publish()
+	 * Use: Replace the current version with a copy of 'new_map' (shares its pages)
+	 *
+	 * @param new_map The new map
+	 * @return void
+	 */
+	void publish(const GameMap &new_map);
+
+	/**
+	 * Function: getVersion()
+	 *
+	 * @param void
+	 * @return unsigned long The current map version (see GameMap::getVersion())
+	 */
+	unsigned long getVersion() const { return acquire()->getVersion(); }
+
+private:
+
+	// The current snapshot (only read/written with atomic_load()/atomic_store())
+	shared_ptr<const GameMap> current;
+
+	// Held while building and publishing a new version
+	mutex writer_mutex;
+};
+
+#endif /* VERSIONEDMAP_HPP_ */
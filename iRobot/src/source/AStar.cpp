@@ -7,30 +7,44 @@
  *              See README.txt for discussion of specific optimizations
  */
 #include "../headers/AStar.hpp"
+#include "../headers/MemProfile.hpp"
 
 using namespace std;
 
 // Generic constructor
 AStar::AStar()
-: iteration_num(0)
+: game_map_ptr(NULL), status(SearchStatus::SEARCH_CANCELLED), robot_radius(0.0f), goal_bounds(NULL), iteration_num(0),
+  max_open_size(0), open_heap(true), octile_heuristic(ASTAR_HEURISTIC_OCTILE)
 {
-
+	open_sort.tie_break = (TieBreak::Type)ASTAR_TIE_BREAK;
 }
 
 // Initialization constructor
-AStar::AStar(const GameMap &game_map, const PosTile &start_pos_arg, const PosTile &end_pos_arg)
-: iteration_num(0)
+AStar::AStar(const GameMap &game_map, const PosTile &start_pos_arg, const PosTile &end_pos_arg,
+             float robot_radius_arg, pmr::memory_resource *memory_arg)
+: parents(memory_arg), f_vals(memory_arg), g_vals(memory_arg), h_vals(memory_arg),
+  game_map_ptr(&game_map), status(SearchStatus::SEARCH_RUNNING), robot_radius(robot_radius_arg), goal_bounds(NULL),
+  iteration_num(0),
+  open_list(memory_arg), max_open_size(0), open_heap(true), octile_heuristic(ASTAR_HEURISTIC_OCTILE)
 {
+	MemScope mem_scope(MemSubsystem::MEM_SEARCH);
+	open_sort.tie_break = (TieBreak::Type)ASTAR_TIE_BREAK;
+
 	// Create the map
-	// Store the matrix in row-major order, so that debugging prints appear
+	// Store the planes in row-major order, so that debugging prints appear
 	//  in a human-readable fashion
-	the_map = vector< vector<NodeInfo> > (game_map.getHeight(),vector<NodeInfo>(game_map.getWidth()));
-	map_width =  the_map[0].size();
-	map_height = the_map.size();
+	map_width =  game_map.getWidth();
+	map_height = game_map.getHeight();
+	size_t num_tiles = (size_t)map_width*map_height;
+	parents.resize(num_tiles);
+	f_vals.resize(num_tiles);
+	g_vals.resize(num_tiles);
+	h_vals.resize(num_tiles);
 
 	// Set the start/end points
 	start_pos = start_pos_arg;
 	end_pos = end_pos_arg;
+	best_pos = start_pos;
 
 	// Calculate the H values for each tile (Manhattan Distance)
 	calcHVals();
@@ -42,38 +56,73 @@ AStar::AStar(const GameMap &game_map, const PosTile &start_pos_arg, const PosTil
 	initOpenList();
 }
 
+// Snapshot constructor
+AStar::AStar(const shared_ptr<const GameMap> &map_snapshot_arg, const PosTile &start_pos_arg,
+             const PosTile &end_pos_arg, float robot_radius_arg, pmr::memory_resource *memory_arg)
+: AStar(*map_snapshot_arg, start_pos_arg, end_pos_arg, robot_radius_arg, memory_arg)
+{
+	map_snapshot = map_snapshot_arg;
+}
+
 // Destructor
 AStar::~AStar()
 {
+	if(iteration_num > 0)
+		memRecordOpenList("AStar", max_open_size, sizeof(OpenListNode));
+}
 
+// Print the search's progress
+void AStar::printProgress() const
+{
+	if(open_list.empty())
+		return;
+	PosTile cur_pos = open_list.front().position;
+	cout << "Running A* iteration: " << iteration_num << ",\t"
+	                                 << open_list.size() << ","
+	                                 << getF(cur_pos) << ","
+	                                 << getG(cur_pos) << ","
+	                                 << getH(cur_pos) << endl;
 }
 
 // Run one step
 void AStar::runStep(const GameMap &game_map, bool &blocked, bool &done)
 {
-	// Notify (so it doesn't look like it's stalled)
-	if(iteration_num%10000 == 0)
-	{
-		PosTile cur_pos = open_list.front().position;
-		cout << "Running A* iteration: " << iteration_num << ",\t"
-		                                 << open_list.size() << ","
-		                                 << the_map[cur_pos.y][cur_pos.x].F << ","
-        								 << the_map[cur_pos.y][cur_pos.x].G << ","
-        								 << the_map[cur_pos.y][cur_pos.x].H << endl;
-	}
+	MemScope mem_scope(MemSubsystem::MEM_SEARCH);
+
 	++iteration_num;
 
 	// Grab the front position from the Open list
 	PosTile cur_tile = open_list.front().position;
+
+	// With a tie-break order the Open list is a binary heap (smallest first): the order is total,
+	// so it gives the same front as sorting, for far less work. The front comes off first, since
+	// a new tile can go in ahead of it (the Manhattan distance can drop by 2 over a 1.4 move)
+	bool use_heap = (open_sort.tie_break != TieBreak::TIE_NONE && open_heap);
+	bool heap_updated = false;
+	auto heap_order = [this](const OpenListNode &a, const OpenListNode &b) { return open_sort(b, a); };
+	if(use_heap)
+	{
+		pop_heap(open_list.begin(), open_list.end(), heap_order);
+		open_list.pop_back();
+	}
+
 	int cur_x = (int)cur_tile.x;	// Convert x to int for manipulation in the switch
 	int cur_y = (int)cur_tile.y;	// Convert y to int for manipulation in the switch
 
 	// Fetch the current Movement Cost
-	float cur_G = the_map[cur_y][cur_x].G;
+	float cur_G = g_vals[cur_y*map_width + cur_x];
+
+	// Remember the tile closest to the end point (partial result for running searches)
+	if(h_vals[cur_y*map_width + cur_x] < getH(best_pos))
+		best_pos = cur_tile;
 
 	// For each direction
 	for(unsigned int dir = 0; dir < (unsigned int) MoveDir::NUM_DIRS; ++dir)
 	{
+		// Skip moves that can't start a shortest path to the end point (see setGoalBounds())
+		if(goal_bounds != NULL && !goal_bounds->canReach(cur_x, cur_y, dir, end_pos))
+			continue;
+
 		int new_x = cur_x, new_y= cur_y;
 
 		// Assess all the movement possibilities
@@ -100,70 +149,83 @@ void AStar::runStep(const GameMap &game_map, bool &blocked, bool &done)
 			continue;
 
 		// Since it's not off the egde, we know it's a valid tile position, so create one
-		PosTile new_tile = { new_x, new_y };
+		PosTile new_tile = { (unsigned int)new_x, (unsigned int)new_y };
 
 
 
-		// Check to see if it's blocked, skip this one if it is
-		if(!game_map.getTraversable(new_x, new_y))
+		// Check to see if it's blocked (or too close to an obstacle for the robot), skip this one if it is
+		if(!game_map.isPassable(new_x, new_y, robot_radius))
 			continue;
 
-/*
- * 		NOTE: THIS HAS BEEN REMOVED FOR SPEED PURPOSES. See README.txt for discussion
-		// Check to see if it's already on the Closed list, skip this one if it is
-		// Find it on the closed list (had to use a custom function, since find() won't take a custom struct
-		//		vector<posTile>::iterator c_it = find(closed_list.begin(), closed_list.end(), new_tile);
-		int c_node_idx = findInClosedList(new_tile);
-		if(c_node_idx != -1)
-			continue;
-*/
+		// NOTE: There is no Closed list check. See README.txt for discussion
+		// An expanded tile can still get a lower G below: the Manhattan heuristic isn't consistent
+		// with 1.4 diagonals, so a cheaper way in may turn up later. Its G and parent are updated,
+		// but it isn't on the Open list any more (findInOpenList() misses it), so it isn't re-opened
+		// and tiles already reached through it keep their old G
 
 		// Calculate the cost to get there
 		float sum_G = cur_G + new_G;
 
 		// Fetch the current cost to get there
-		float new_pos_G = the_map[new_y][new_x].G;
-		float new_pos_F = the_map[new_y][new_x].F;
+		size_t new_idx = (size_t)new_y*map_width + new_x;
+		float new_pos_G = g_vals[new_idx];
+		float new_pos_F = f_vals[new_idx];
 
 		// If the travel cost to get to the new tile from the current tile is either
 		//  uninitialized or lower than previous attemtps, push it onto the list
 		if(new_pos_G == -1 || sum_G < new_pos_G)
 		{
 			// Set the parent of the new tile to current tile
-			the_map[new_y][new_x].parent = cur_tile;
+			parents[new_idx] = cur_tile;
 
 			// Reset the G, and recalculate the F
-			the_map[new_y][new_x].G = sum_G;
-			the_map[new_y][new_x].F = the_map[new_y][new_x].G + the_map[new_y][new_x].H;
+			g_vals[new_idx] = sum_G;
+			f_vals[new_idx] = g_vals[new_idx] + h_vals[new_idx];
 
 			// If it's a completely uninitialized tile
 			if(new_pos_G == -1)
 			{
 				// Push this tile onto the Open list
-				OpenListNode new_oln = { new_tile, the_map[new_y][new_x].F };
+				OpenListNode new_oln = { new_tile, f_vals[new_idx], calcTieKey(new_idx) };
 				open_list.push_back( new_oln );
+				if(use_heap)
+					push_heap(open_list.begin(), open_list.end(), heap_order);
 			}
 			// If we're updating the score of a tile already on the Open list
 			else
 			{
 				// Create an OpenListNode of the old pattern, to search for it
-				OpenListNode search_node = { new_tile, new_pos_F };
+				OpenListNode search_node = { new_tile, new_pos_F, 0 };
 
 				// Find it on the open list (had to use a custom function, since find() won't take a custom struct
 				//				deque<OpenListNode>::iterator o_it = find(open_list.begin(), open_list.end(), search_node);
 				int o_node_idx = findInOpenList(search_node);
 				if(o_node_idx != -1)
-					open_list[o_node_idx].F = the_map[new_y][new_x].F;
+				{
+					open_list[o_node_idx].F = f_vals[new_idx];
+					open_list[o_node_idx].tie = calcTieKey(new_idx);
+					heap_updated = true;
+				}
 			}
 		}
 	}
 
-	// Put the used tile on the Closed list, and remove it from the Open list
-	closed_list.push_back(cur_tile);
-	open_list.pop_front();
+	if(use_heap)
+	{
+		// Restore the heap if a tile on it got a better key
+		max_open_size = max(max_open_size, open_list.size() + 1);
+		if(heap_updated)
+			make_heap(open_list.begin(), open_list.end(), heap_order);
+	}
+	else
+	{
+		// Remove the used tile from the Open list
+		max_open_size = max(max_open_size, open_list.size());
+		open_list.pop_front();
 
-	// Sort the Open list (smallest F value first)
-	std::sort(open_list.begin(), open_list.end(), open_sort );
+		// Sort the Open list (smallest F value first)
+		std::sort(open_list.begin(), open_list.end(), open_sort );
+	}
 
 #if DEBUG
 	// Print the map (debugging)
@@ -178,6 +240,7 @@ void AStar::runStep(const GameMap &game_map, bool &blocked, bool &done)
 	if(open_list.size() == 0)
 	{
 		blocked = true;
+		status = SearchStatus::SEARCH_UNREACHABLE;
 		return;
 	}
 
@@ -187,25 +250,73 @@ void AStar::runStep(const GameMap &game_map, bool &blocked, bool &done)
 	   open_list.front().position.y == end_pos.y)
 	{
 		done = true;
+		status = SearchStatus::SEARCH_FOUND;
+		best_pos = end_pos;
 		return;
 	}
 }
 
-// Get the full path string
-void AStar::getPathString(stringstream &path_string)
+// Run up to max_expansions steps
+SearchStatus::Type AStar::advance(unsigned long max_expansions)
+{
+	bool blocked = false, done = false;
+	for(unsigned long step = 0; step < max_expansions && status == SearchStatus::SEARCH_RUNNING; ++step)
+		runStep(*game_map_ptr, blocked, done);
+
+	return status;
+}
+
+// Run steps until the deadline passes
+SearchStatus::Type AStar::advanceUntil(const chrono::steady_clock::time_point &deadline)
+{
+	// Sample the clock in batches, since a single expansion is much cheaper than now()
+	while(status == SearchStatus::SEARCH_RUNNING && chrono::steady_clock::now() < deadline)
+		advance(DEADLINE_CHECK_STEPS);
+
+	return status;
+}
+
+// Abandon the search
+void AStar::cancel()
+{
+	if(status == SearchStatus::SEARCH_RUNNING)
+		status = SearchStatus::SEARCH_CANCELLED;
+}
+
+// Prune moves with goal bounds
+bool AStar::setGoalBounds(const GoalBounds *goal_bounds_arg)
+{
+	goal_bounds = NULL;
+	if(goal_bounds_arg == NULL || !goal_bounds_arg->isReady() || robot_radius > 0.0f ||
+	   goal_bounds_arg->getWidth() != map_width || goal_bounds_arg->getHeight() != map_height)
+		return false;
+
+	goal_bounds = goal_bounds_arg;
+	return true;
+}
+
+// Get the full path (or the path to the best node so far)
+void AStar::getPath(vector<PosTile> &path) const
 {
 	// Assemble the completion path (starts at end, ends at start, because of how A* works)
-	vector<PosTile> a_star_path;
-	PosTile cur_tile = open_list.front().position;
+	path.clear();
+	PosTile cur_tile = best_pos;
 	while(cur_tile.x != start_pos.x || cur_tile.y != start_pos.y)
 	{
-		a_star_path.push_back(cur_tile);
-		cur_tile = the_map[cur_tile.y][cur_tile.x].parent;
+		path.push_back(cur_tile);
+		cur_tile = parents[cur_tile.y*map_width + cur_tile.x];
 	}
-	a_star_path.push_back(start_pos); // Add the start pos to complete the path
+	path.push_back(start_pos); // Add the start pos to complete the path
 
 	// Reverse the list
-	reverse(a_star_path.begin(), a_star_path.end());
+	reverse(path.begin(), path.end());
+}
+
+// Get the full path string
+void AStar::getPathString(stringstream &path_string)
+{
+	vector<PosTile> a_star_path;
+	getPath(a_star_path);
 
 	// Add each location to the stringstream
 	unsigned int path_size = a_star_path.size();
@@ -217,48 +328,53 @@ void AStar::getPathString(stringstream &path_string)
 // Calculate the (H)euristic values for all tiles
 void AStar::calcHVals()
 {
-	// Use Manhattan Distance to estimate travel time from each node to the end point
+	// Use Manhattan (or octile) Distance to estimate travel time from each node to the end point
+	// Every tile of a row is the same vertical distance away, so whole rows go to the kernel
 	for(unsigned int row_idx = 0; row_idx < map_height; ++row_idx)
 	{
-		for(unsigned int col_idx = 0; col_idx < map_width; ++col_idx)
-		{
-			// Calculate the manhattan
-			int manhattan = 0;									// Needs to be an 'int' so the abs() doen't create math errors
-			manhattan += abs((int)end_pos.x - (int)col_idx);	// Add the absolute horizontal difference
-			manhattan += abs((int)end_pos.y - (int)row_idx);	// Add the absolute vertical difference
-
-			// Assign it to the AStar map
-			the_map[row_idx][col_idx].H = (float) manhattan;
-		}
+		unsigned int row_dist = abs((int)end_pos.y - (int)row_idx);	// Needs to be an 'int' so the abs() doen't create math errors
+		if(octile_heuristic)
+			kernelOctileRow(&h_vals[(size_t)row_idx*map_width], map_width, end_pos.x, row_dist);
+		else
+			kernelManhattanRow(&h_vals[(size_t)row_idx*map_width], map_width, end_pos.x, row_dist);
 	}
 }
 
+// Choose the heuristic
+void AStar::setOctileHeuristic(bool octile_arg)
+{
+	bool changed = (octile_arg != octile_heuristic);
+	octile_heuristic = octile_arg;
+	if(!changed || game_map_ptr == NULL || iteration_num > 0)
+		return;
+
+	// Only the start node has a score so far
+	calcHVals();
+	open_list.clear();
+	initOpenList();
+}
+
 // Initialize the F/G values to a value signifying "UNINITIALIZED"
 void AStar::initFGVals()
 {
-	for(unsigned int row_idx = 0; row_idx < map_height; ++row_idx)
-	{
-		for(unsigned int col_idx = 0; col_idx < map_width; ++col_idx)
-		{
-			the_map[row_idx][col_idx].F = FG_UNINIT;
-			the_map[row_idx][col_idx].G = FG_UNINIT;
-		}
-	}
+	kernelFill(f_vals.data(), f_vals.size(), FG_UNINIT);
+	kernelFill(g_vals.data(), g_vals.size(), FG_UNINIT);
 }
 
 // Prepare the first node
 void AStar::initOpenList()
 {
 	// Set the correct value for G and F
-	the_map[start_pos.y][start_pos.x].G = 0;
-	the_map[start_pos.y][start_pos.x].F = the_map[start_pos.y][start_pos.x].H;
+	size_t start_idx = (size_t)start_pos.y*map_width + start_pos.x;
+	g_vals[start_idx] = 0;
+	f_vals[start_idx] = h_vals[start_idx];
 
 	// Push the Start position onto the Open list
-	OpenListNode new_oln = { start_pos, the_map[start_pos.y][start_pos.x].F };
+	OpenListNode new_oln = { start_pos, f_vals[start_idx], calcTieKey(start_idx) };
 	open_list.push_back(new_oln);
 }
 
-// Search algorithms for objects on open/closed lists
+// Search algorithm for objects on the Open list
 int AStar::findInOpenList(OpenListNode &search_node)
 {
 	int found_idx = -1;
@@ -274,27 +390,11 @@ int AStar::findInOpenList(OpenListNode &search_node)
 	return found_idx;
 }
 
-int AStar::findInClosedList(PosTile &search_tile)
-{
-	int found_idx = -1;
-	unsigned int list_size = closed_list.size();
-
-	for(unsigned int list_idx = 0; list_idx < list_size; ++list_idx)
-	{
-		if(search_tile.x == closed_list[list_idx].x &&
-		   search_tile.y == closed_list[list_idx].y)
-			return list_idx;
-	}
-
-	return found_idx;
-}
-
 
 
 
 void AStar::printMap()
 {
-	cout << "AStar size: (" << the_map[0].size() << "," << the_map.size() << ")" << endl;
 	cout << "AStar size: (" << map_width << "," << map_height << ")" << endl;
 
 	// Cycle through the object printing the vectors
@@ -303,12 +403,13 @@ void AStar::printMap()
 		cout << "row: " << row_idx << endl;
 		for(unsigned int col_idx = 0; col_idx < map_width; ++col_idx)
 		{
+			size_t tile_idx = (size_t)row_idx*map_width + col_idx;
 			cout << "AStar tile (" << col_idx << "," << row_idx << "):" << endl;
-			cout << "\tParent (" << the_map[row_idx][col_idx].parent.x << "," <<
-					the_map[row_idx][col_idx].parent.y << ")" << endl;
-			cout << "\tF: " << the_map[row_idx][col_idx].F << endl;
-			cout << "\tG: " << the_map[row_idx][col_idx].G << endl;
-			cout << "\tH: " << the_map[row_idx][col_idx].H << endl;
+			cout << "\tParent (" << parents[tile_idx].x << "," <<
+					parents[tile_idx].y << ")" << endl;
+			cout << "\tF: " << f_vals[tile_idx] << endl;
+			cout << "\tG: " << g_vals[tile_idx] << endl;
+			cout << "\tH: " << h_vals[tile_idx] << endl;
 		}
 		//cout << endl;
 //		cin.ignore();
@@ -0,0 +1,1320 @@
+/**
+ * Benchmark.cpp
+ *  Created on: Oct 18, 2026
+ *      Author: iRobot maintainers
+ *     Purpose: Command line benchmarks ('iRobot bench <name> ...')
+ */
+#include "../headers/Benchmark.hpp"
+#include "../headers/CooperativePlanner.hpp"
+#include "../headers/SubgoalGraph.hpp"
+#include "../headers/AStar.hpp"
+#include "../headers/GridKernels.hpp"
+#include "../headers/MapGenerator.hpp"
+#include "../headers/VersionedMap.hpp"
+#include "../headers/Parallel.hpp"
+#include "../headers/SearchArena.hpp"
+#include "../headers/SearchScheduler.hpp"
+#include "../headers/PathCache.hpp"
+#include "../headers/FringeSearch.hpp"
+#include "../headers/MemProfile.hpp"
+
+#include <set>
+#include <map>
+#include <memory>
+#include <functional>
+#include <atomic>
+#include <thread>
+
+using namespace std;
+
+// Time steps the cooperative benchmark allows before giving up (and for its corridor check)
+#define COOP_MAX_TIME	20000
+#define COOP_CORRIDOR_MAX_TIME	64
+
+// Obstacle density of the kernel benchmark's random maps (the sparse one shows
+// scanning past long obstacle runs)
+#define KERNEL_BENCH_DENSITY	0.3
+#define KERNEL_BENCH_SPARSE_DENSITY	0.9999
+
+// Expansions per advance() call in the snapshot benchmark (lets the writer interleave)
+#define SNAPSHOT_BENCH_SLICE	1000
+
+// Width/height (in tiles) of the obstacle blocks the path cache benchmark adds and clears
+#define CACHE_BENCH_BLOCK	4
+
+// Time limit for AStar in the low-memory engine benchmark (exhausting a large map
+// with no path takes AStar far longer)
+#define FRINGE_BENCH_ASTAR_SECONDS	60
+
+// Time limit for each AStar search in the tie-break benchmark
+#define TIE_BENCH_ASTAR_SECONDS	60
+
+// Obstacle density of the clearance check's random map, and the error it allows (tiles)
+#define CLEARANCE_BENCH_DENSITY	0.001
+#define CLEARANCE_BENCH_TOLERANCE	0.01
+
+/**
+ * Function: nextRandom()
+ * Use: splitmix64 step (same generator as MapGenerator, so picks repeat across platforms)
+ *
+ * @param state The generator state
+ * @return A uniformly distributed 64-bit value
+ */
+static unsigned long long nextRandom(unsigned long long &state)
+{
+	unsigned long long z = (state += 0x9E3779B97F4A7C15ULL);
+	z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+	z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+	return z ^ (z >> 31);
+}
+
+/**
+ * Function: pickFreeTiles()
+ * Use: Pick distinct random traversable tiles
+ *
+ * @param game_map The traversability map
+ * @param num_tiles The number of tiles to pick
+ * @param seed The random seed
+ * @param tiles The return tiles (fewer than 'num_tiles' if the map is nearly full)
+ * @return void
+ */
+static void pickFreeTiles(const GameMap &game_map, unsigned int num_tiles, unsigned long long seed,
+                          vector<PosTile> &tiles)
+{
+	tiles.clear();
+	set< pair<unsigned int, unsigned int> > used;
+	unsigned long long max_tries = (unsigned long long)num_tiles*1000 + 1000;
+	for(unsigned long long try_idx = 0; try_idx < max_tries && tiles.size() < num_tiles; ++try_idx)
+	{
+		PosTile tile = { (unsigned int)(nextRandom(seed) % game_map.getWidth()),
+		                 (unsigned int)(nextRandom(seed) % game_map.getHeight()) };
+		if(!game_map.getTraversable(tile.x, tile.y) || !used.insert(make_pair(tile.x, tile.y)).second)
+			continue;
+		tiles.push_back(tile);
+	}
+}
+
+/**
+ * Function: countCollisions()
+ * Use: Check the cooperative planner's paths for two robots on one tile at the same time (vertex),
+ *      and for two robots trading tiles in one step (swap)
+ *
+ * @param planner The planner, after planAll()
+ * @param map_width The map width
+ * @param num_vertex The return number of vertex conflicts
+ * @param num_swaps The return number of swap conflicts
+ * @return void
+ */
+static void countCollisions(const CooperativePlanner &planner, unsigned int map_width,
+                            unsigned int &num_vertex, unsigned int &num_swaps)
+{
+	num_vertex = num_swaps = 0;
+	unsigned int num_robots = planner.getNumRobots();
+	map< pair<unsigned long long, unsigned int>, unsigned int > occupied;	// (tile, time) -> robot
+	for(unsigned int robot_idx = 0; robot_idx < num_robots; ++robot_idx)
+	{
+		const vector<PosTile> &path = planner.getPath(robot_idx);
+		for(unsigned int time_idx = 0; time_idx < path.size(); ++time_idx)
+		{
+			unsigned long long tile_id = (unsigned long long)path[time_idx].y*map_width + path[time_idx].x;
+			if(!occupied.insert(make_pair(make_pair(tile_id, time_idx), robot_idx)).second)
+				++num_vertex;
+		}
+	}
+
+	// A robot moving p -> q while the robot that was on q moves to p (each pair is seen twice)
+	for(unsigned int robot_idx = 0; robot_idx < num_robots; ++robot_idx)
+	{
+		const vector<PosTile> &path = planner.getPath(robot_idx);
+		for(unsigned int time_idx = 0; time_idx + 1 < path.size(); ++time_idx)
+		{
+			unsigned long long from_id = (unsigned long long)path[time_idx].y*map_width + path[time_idx].x;
+			unsigned long long to_id = (unsigned long long)path[time_idx + 1].y*map_width + path[time_idx + 1].x;
+			if(from_id == to_id)
+				continue;
+			auto other = occupied.find(make_pair(to_id, time_idx));
+			if(other == occupied.end() || other->second == robot_idx)
+				continue;
+			auto other_next = occupied.find(make_pair(from_id, time_idx + 1));
+			if(other_next != occupied.end() && other_next->second == other->second)
+				++num_swaps;
+		}
+	}
+	num_swaps /= 2;
+}
+
+/**
+ * Function: pathCost()
+ *
+ * @param path The tiles of a path
+ * @return float The path's cost (1 per straight move, 1.4 per diagonal, as in AStar)
+ */
+static float pathCost(const vector<PosTile> &path)
+{
+	float cost = 0.0f;
+	for(unsigned int tile_idx = 1; tile_idx < path.size(); ++tile_idx)
+	{
+		bool diagonal = (path[tile_idx].x != path[tile_idx - 1].x && path[tile_idx].y != path[tile_idx - 1].y);
+		cost += diagonal ? 1.4f : 1.0f;
+	}
+	return cost;
+}
+
+// Dispatch a benchmark
+int runBenchmark(int argc, char *argv[])
+{
+	string bench_name = (argc > 2) ? argv[2] : "";
+
+	if(bench_name == "coop" && argc > 3)
+	{
+		GameMap game_map;
+		PosTile map_start, map_end;
+		if(!game_map.loadFile(argv[3], map_start, map_end))
+			return 1;
+
+		unsigned int num_robots = (argc > 4) ? strtoul(argv[4], NULL, 10) : 100;
+		unsigned int window     = (argc > 5) ? strtoul(argv[5], NULL, 10) : 16;
+		unsigned long long seed = (argc > 6) ? strtoull(argv[6], NULL, 10) : 1;
+		benchCooperative(game_map, num_robots, window, seed);
+		return 0;
+	}
+
+	if(bench_name == "subgoal" && argc > 3)
+	{
+		GameMap game_map;
+		PosTile map_start, map_end;
+		if(!game_map.loadFile(argv[3], map_start, map_end))
+			return 1;
+
+		unsigned int num_queries = (argc > 4) ? strtoul(argv[4], NULL, 10) : 1000;
+		unsigned int num_checks  = (argc > 5) ? strtoul(argv[5], NULL, 10) : 0;
+		benchSubgoal(game_map, argv[3], num_queries, num_checks);
+		return 0;
+	}
+
+	if(bench_name == "snapshots" && argc > 3)
+	{
+		GameMap game_map;
+		PosTile map_start, map_end;
+		if(!game_map.loadFile(argv[3], map_start, map_end))
+			return 1;
+
+		unsigned int num_searches = (argc > 4) ? strtoul(argv[4], NULL, 10) : 20;
+		unsigned int block_size   = (argc > 5) ? strtoul(argv[5], NULL, 10) : 16;
+		benchSnapshots(game_map, num_searches, max(block_size, 1u));
+		return 0;
+	}
+
+	if(bench_name == "kernels")
+	{
+		unsigned int width  = (argc > 3) ? strtoul(argv[3], NULL, 10) : 1500;
+		unsigned int height = (argc > 4) ? strtoul(argv[4], NULL, 10) : width;
+		unsigned int reps   = (argc > 5) ? strtoul(argv[5], NULL, 10) : 5;
+		if(width == 0 || height == 0 || reps == 0)
+			return 1;
+		benchKernels(width, height, reps);
+		return 0;
+	}
+
+	if(bench_name == "clearance")
+	{
+		unsigned int width  = (argc > 3) ? strtoul(argv[3], NULL, 10) : 16000;
+		unsigned int height = (argc > 4) ? strtoul(argv[4], NULL, 10) : 64;
+		double density      = (argc > 5) ? strtod(argv[5], NULL) : CLEARANCE_BENCH_DENSITY;
+		if(width == 0 || height == 0)
+			return 1;
+		return benchClearance(width, height, density) ? 0 : 1;
+	}
+
+	if(bench_name == "alloc" && argc > 3)
+	{
+		GameMap game_map;
+		PosTile map_start, map_end;
+		if(!game_map.loadFile(argv[3], map_start, map_end))
+			return 1;
+
+		unsigned int num_queries = (argc > 4) ? strtoul(argv[4], NULL, 10) : 20;
+		benchAlloc(game_map, num_queries);
+		return 0;
+	}
+
+	if(bench_name == "scheduler" && argc > 3)
+	{
+		GameMap game_map;
+		PosTile map_start, map_end;
+		if(!game_map.loadFile(argv[3], map_start, map_end))
+			return 1;
+
+		unsigned int num_searches = (argc > 4) ? strtoul(argv[4], NULL, 10) : 16;
+		unsigned long quantum     = (argc > 5) ? strtoul(argv[5], NULL, 10) : 100;
+		benchScheduler(game_map, num_searches, max(quantum, 1ul));
+		return 0;
+	}
+
+	if(bench_name == "cache" && argc > 3)
+	{
+		GameMap game_map;
+		PosTile map_start, map_end;
+		if(!game_map.loadFile(argv[3], map_start, map_end))
+			return 1;
+
+		unsigned int num_lookups  = (argc > 4) ? strtoul(argv[4], NULL, 10) : 5000;
+		unsigned int num_queries  = (argc > 5) ? strtoul(argv[5], NULL, 10) : 200;
+		unsigned int update_every = (argc > 6) ? strtoul(argv[6], NULL, 10) : 50;
+		size_t max_kb             = (argc > 7) ? strtoul(argv[7], NULL, 10) : 1024;
+		benchCache(game_map, num_lookups, num_queries, update_every, max_kb*1024);
+		return 0;
+	}
+
+	if(bench_name == "fringe" && argc > 4)
+	{
+		size_t max_kb = strtoul(argv[3], NULL, 10);
+		vector<string> map_files(argv + 4, argv + argc);
+		benchFringe(map_files, ((max_kb > 0) ? max_kb : FRINGE_MAX_KB)*1024);
+		return 0;
+	}
+
+	if(bench_name == "load" && argc > 3)
+	{
+		vector<string> map_files(argv + 3, argv + argc);
+		benchLoad(map_files, 3);
+		return 0;
+	}
+
+	if(bench_name == "goalbounds" && argc > 3)
+	{
+		GameMap game_map;
+		PosTile map_start, map_end;
+		if(!game_map.loadFile(argv[3], map_start, map_end))
+			return 1;
+
+		unsigned int num_queries = (argc > 4) ? strtoul(argv[4], NULL, 10) : 100;
+		benchGoalBounds(game_map, argv[3], num_queries);
+		return 0;
+	}
+
+	if(bench_name == "ties" && argc > 3)
+	{
+		vector<string> map_files(argv + 3, argv + argc);
+		benchTieBreak(map_files);
+		return 0;
+	}
+
+	cout << "Usage: " << argv[0] << " bench <name> [arguments...]" << endl;
+	cout << "\tcoop <map file> [num_robots (100)] [window (16)] [seed (1)]" << endl;
+	cout << "\tsubgoal <map file> [num_queries (1000)] [num_astar_checks (0)]" << endl;
+	cout << "\tsnapshots <map file> [num_searches (20)] [block_size (16)]" << endl;
+	cout << "\tkernels [width (1500)] [height (width)] [reps (5)]" << endl;
+	cout << "\tclearance [width (16000)] [height (64)] [density (0.001)]" << endl;
+	cout << "\talloc <map file> [num_queries (20)]" << endl;
+	cout << "\tscheduler <map file> [num_searches (16)] [quantum (100)]" << endl;
+	cout << "\tcache <map file> [num_lookups (5000)] [num_queries (200)] [update_every (50)] [max_kb (1024)]" << endl;
+	cout << "\tfringe <max_kb (0 = FRINGE_MAX_KB)> <map file> [map file...]" << endl;
+	cout << "\tload <map file> [map file...]" << endl;
+	cout << "\tgoalbounds <map file> [num_queries (100)]" << endl;
+	cout << "\tties <map file> [map file...]" << endl;
+	return 1;
+}
+
+// Cooperative planner benchmark
+void benchCooperative(const GameMap &game_map, unsigned int num_robots, unsigned int window,
+                      unsigned long long seed)
+{
+	// Starts and goals all distinct (a start may be another robot's goal)
+	vector<PosTile> starts, goals;
+	pickFreeTiles(game_map, num_robots, seed, starts);
+	pickFreeTiles(game_map, num_robots, seed + 1, goals);
+	num_robots = min(starts.size(), goals.size());
+
+	chrono::steady_clock::time_point begin_time = chrono::steady_clock::now();
+	CooperativePlanner planner(game_map, window);
+	for(unsigned int robot_idx = 0; robot_idx < num_robots; ++robot_idx)
+		planner.addRobot(starts[robot_idx], goals[robot_idx]);
+	bool all_arrived = planner.planAll(COOP_MAX_TIME);
+	double seconds = chrono::duration<double>(chrono::steady_clock::now() - begin_time).count();
+
+	// Count robots at their goals, and check the plans for collisions
+	unsigned int num_arrived = 0, num_unreachable = 0, num_vertex = 0, num_swaps = 0;
+	unsigned int makespan = (num_robots == 0) ? 0 : planner.getPath(0).size() - 1;
+	for(unsigned int robot_idx = 0; robot_idx < num_robots; ++robot_idx)
+	{
+		const vector<PosTile> &path = planner.getPath(robot_idx);
+		if(path.back().x == goals[robot_idx].x && path.back().y == goals[robot_idx].y)
+			++num_arrived;
+		if(!planner.getReachable(robot_idx))
+			++num_unreachable;
+	}
+	countCollisions(planner, game_map.getWidth(), num_vertex, num_swaps);
+
+	cout << "Cooperative planner: " << num_robots << " robots, window " << window << endl;
+	cout << "\tarrived: " << num_arrived << "/" << num_robots << " (" << num_unreachable << " unreachable)"
+	     << (all_arrived ? "" : " (time limit hit)") << ", makespan: " << makespan
+	     << " steps, vertex conflicts: " << num_vertex << ", swap conflicts: " << num_swaps << endl;
+	cout << "\ttime: " << seconds*1000.0 << " ms, robots planned per second: "
+	     << ((seconds > 0.0) ? num_robots / seconds : 0.0)
+	     << ", space-time expansions: " << planner.getNumExpanded() << endl;
+
+	// Two robots meeting head-on in a 4x1 corridor (row 1 blocked): they can't pass, so neither
+	// may arrive, but they must not end up on the same tile while one waits for the other
+	vector<uint64_t> corridor_words(2, 0);
+	corridor_words[1] = 0xF;
+	GameMap corridor_map(corridor_words, 4, 2);
+	CooperativePlanner corridor_planner(corridor_map, 4);
+	PosTile corridor_tiles[4] = { { 1, 0 }, { 0, 0 }, { 0, 0 }, { 3, 0 } };
+	corridor_planner.addRobot(corridor_tiles[0], corridor_tiles[1]);
+	corridor_planner.addRobot(corridor_tiles[2], corridor_tiles[3]);
+	corridor_planner.planAll(COOP_CORRIDOR_MAX_TIME);
+	countCollisions(corridor_planner, corridor_map.getWidth(), num_vertex, num_swaps);
+	cout << "\tcorridor check (2 robots head-on, 4x1, window 4): vertex conflicts: " << num_vertex
+	     << ", swap conflicts: " << num_swaps << endl;
+}
+
+// Subgoal graph benchmark
+void benchSubgoal(const GameMap &game_map, const string &map_file_name, unsigned int num_queries,
+                  unsigned int num_checks)
+{
+	// Preprocess, then save and reload the side file (as a later run would)
+	SubgoalGraph subgoal_graph;
+	chrono::steady_clock::time_point begin_time = chrono::steady_clock::now();
+	subgoal_graph.build(game_map);
+	double build_seconds = chrono::duration<double>(chrono::steady_clock::now() - begin_time).count();
+
+	string side_file_name = SubgoalGraph::getSideFileName(map_file_name);
+	begin_time = chrono::steady_clock::now();
+	bool saved = subgoal_graph.save(side_file_name) && subgoal_graph.load(side_file_name, game_map);
+	double load_seconds = chrono::duration<double>(chrono::steady_clock::now() - begin_time).count();
+
+	cout << "Subgoal graph: " << subgoal_graph.getNumNodes()
+	     << " subgoals, " << subgoal_graph.getNumEdges() << " edges" << endl;
+	cout << "\tbuild: " << build_seconds*1000.0 << " ms, save + load " << side_file_name << ": "
+	     << (saved ? "" : "FAILED ") << load_seconds*1000.0 << " ms" << endl;
+
+	// Random (seeded) queries
+	vector<PosTile> starts, goals;
+	pickFreeTiles(game_map, num_queries, 1, starts);
+	pickFreeTiles(game_map, num_queries, 2, goals);
+	num_queries = min(starts.size(), goals.size());
+
+	vector< vector<PosTile> > paths(num_queries);
+	vector<bool> found(num_queries);
+	unsigned int num_found = 0;
+	begin_time = chrono::steady_clock::now();
+	for(unsigned int query_idx = 0; query_idx < num_queries; ++query_idx)
+	{
+		found[query_idx] = subgoal_graph.findPath(starts[query_idx], goals[query_idx], paths[query_idx]);
+		num_found += found[query_idx] ? 1 : 0;
+	}
+	double query_seconds = chrono::duration<double>(chrono::steady_clock::now() - begin_time).count();
+
+	cout << "\tqueries: " << num_found << "/" << num_queries << " found, "
+	     << ((num_queries > 0) ? query_seconds*1.0e6 / num_queries : 0.0) << " us per query" << endl;
+
+	// Compare the first few against AStar (much slower)
+	if(num_checks == 0)
+		return;
+	num_checks = min(num_checks, num_queries);
+	unsigned int num_agree = 0, num_longer = 0;
+	float max_extra = 0.0f;
+	double astar_seconds = 0.0;
+	for(unsigned int query_idx = 0; query_idx < num_checks; ++query_idx)
+	{
+		begin_time = chrono::steady_clock::now();
+		AStar a_star(game_map, starts[query_idx], goals[query_idx]);
+		while(a_star.advance(100000) == SearchStatus::SEARCH_RUNNING)
+			;
+		astar_seconds += chrono::duration<double>(chrono::steady_clock::now() - begin_time).count();
+
+		// Subgoal paths can't cut corners, so they can be much longer than AStar's on maze-like maps
+		bool astar_found = (a_star.getStatus() == SearchStatus::SEARCH_FOUND);
+		if(astar_found == found[query_idx])
+			++num_agree;
+		if(astar_found && found[query_idx])
+		{
+			vector<PosTile> astar_path;
+			a_star.getPath(astar_path);
+			float extra = pathCost(paths[query_idx]) - pathCost(astar_path);
+			num_longer += (extra > 1.0e-3f) ? 1 : 0;
+			max_extra = max(max_extra, extra);
+		}
+	}
+	cout << "\tAStar check: " << num_agree << "/" << num_checks << " agree on reachability, " << num_longer
+	     << " subgoal paths longer, largest extra cost " << max_extra << ", AStar " << astar_seconds*1.0e6 / num_checks
+	     << " us per query" << endl;
+}
+
+// Grid kernel benchmark
+void benchKernels(unsigned int width, unsigned int height, unsigned int reps)
+{
+	MapGenerator generator(width, height, 1);
+	generator.generate(MapTopology::TOPO_RANDOM, KERNEL_BENCH_DENSITY);
+	GameMap game_map(generator.getObstacleWords(), width, height);
+	generator.generate(MapTopology::TOPO_RANDOM, KERNEL_BENCH_SPARSE_DENSITY);
+	GameMap sparse_map(generator.getObstacleWords(), width, height);
+	size_t num_tiles = (size_t)width*height;
+	PosTile start = { 0, 0 }, goal = { width/3, height/2 };
+
+	// Best time of 'reps' runs of 'pass' (ms)
+	auto timePass = [reps](const function<void()> &pass)
+	{
+		double best_ms = 0.0;
+		for(unsigned int rep_idx = 0; rep_idx < reps; ++rep_idx)
+		{
+			chrono::steady_clock::time_point begin_time = chrono::steady_clock::now();
+			pass();
+			double cur_ms = chrono::duration<double, milli>(chrono::steady_clock::now() - begin_time).count();
+			best_ms = (rep_idx == 0) ? cur_ms : min(best_ms, cur_ms);
+		}
+		return best_ms;
+	};
+
+	cout << "Grid kernels: " << width << "x" << height << " (" << num_tiles << " tiles), best of " << reps
+	     << " runs, CPU supports " << getKernelLevelName(getBestKernelLevel()) << endl;
+
+	// The old layout for comparison: a 20-byte node per tile, initialised one field at a time
+	{
+		struct NodeInfo { PosTile parent; float F, G, H; };
+		vector< vector<NodeInfo> > old_map(height, vector<NodeInfo>(width));
+		double old_ms = timePass([&]()
+		{
+			for(unsigned int row_idx = 0; row_idx < height; ++row_idx)
+				for(unsigned int col_idx = 0; col_idx < width; ++col_idx)
+				{
+					old_map[row_idx][col_idx].H = (float)(abs((int)goal.x - (int)col_idx) + abs((int)goal.y - (int)row_idx));
+					old_map[row_idx][col_idx].F = FG_UNINIT;
+					old_map[row_idx][col_idx].G = FG_UNINIT;
+				}
+		});
+		cout << "\tarray-of-structs F/G/H init (old AStar layout): " << old_ms << " ms" << endl;
+	}
+
+	// Each pass at each supported level. Results must match the scalar level exactly
+	KernelLevel::Type best_level = getBestKernelLevel();
+	vector<float> plane_a(num_tiles), plane_b(num_tiles);
+	const char *pass_names[] = { "G/F fill (2 planes)", "Manhattan H", "octile H", "count traversable",
+	                             "scan traversable", "scan traversable (sparse map)", "AStar setup" };
+	const unsigned int num_passes = sizeof(pass_names) / sizeof(pass_names[0]);
+	double pass_ms[num_passes][KernelLevel::NUM_LEVELS];
+	size_t scalar_count = 0;
+	uint64_t scalar_hashes[2] = { 0, 0 };
+	bool all_match = true;
+
+	// Hash of a plane's exact bits
+	auto hashPlane = [num_tiles](const vector<float> &plane)
+	{
+		uint64_t hash = 0xCBF29CE484222325ULL;
+		for(size_t tile_idx = 0; tile_idx < num_tiles; ++tile_idx)
+		{
+			uint32_t bits;
+			memcpy(&bits, &plane[tile_idx], sizeof(bits));
+			hash = (hash ^ bits) * 0x100000001B3ULL;
+		}
+		return hash;
+	};
+	for(int level = KernelLevel::KERNEL_SCALAR; level <= best_level; ++level)
+	{
+		setKernelLevel((KernelLevel::Type)level);
+
+		pass_ms[0][level] = timePass([&]()
+		{
+			kernelFill(plane_a.data(), num_tiles, FG_UNINIT);
+			kernelFill(plane_b.data(), num_tiles, FG_UNINIT);
+		});
+		all_match = all_match && (count(plane_a.begin(), plane_a.end(), FG_UNINIT) == (long)num_tiles);
+
+		pass_ms[1][level] = timePass([&]()
+		{
+			for(unsigned int row_idx = 0; row_idx < height; ++row_idx)
+				kernelManhattanRow(&plane_a[(size_t)row_idx*width], width, goal.x, abs((int)goal.y - (int)row_idx));
+		});
+		pass_ms[2][level] = timePass([&]()
+		{
+			for(unsigned int row_idx = 0; row_idx < height; ++row_idx)
+				kernelOctileRow(&plane_b[(size_t)row_idx*width], width, goal.x, abs((int)goal.y - (int)row_idx));
+		});
+		uint64_t hashes[2] = { hashPlane(plane_a), hashPlane(plane_b) };
+		if(level == KernelLevel::KERNEL_SCALAR)
+			memcpy(scalar_hashes, hashes, sizeof(hashes));
+		all_match = all_match && (hashes[0] == scalar_hashes[0]) && (hashes[1] == scalar_hashes[1]) &&
+		            (plane_a[0] == (float)(goal.x + goal.y));
+
+		// Visit every traversable tile of a map, row by row
+		auto scanMap = [width, height](const GameMap &scan_map)
+		{
+			size_t num_scanned = 0;
+			for(unsigned int row_idx = 0; row_idx < height; ++row_idx)
+				for(unsigned int col_idx = scan_map.findTraversable(0, row_idx); col_idx < width;
+				    col_idx = scan_map.findTraversable(col_idx + 1, row_idx))
+					++num_scanned;
+			return num_scanned;
+		};
+		size_t num_counted = 0, num_scanned = 0, num_sparse = 0;
+		pass_ms[3][level] = timePass([&]() { num_counted = game_map.countTraversable(); });
+		pass_ms[4][level] = timePass([&]() { num_scanned = scanMap(game_map); });
+		pass_ms[5][level] = timePass([&]() { num_sparse = scanMap(sparse_map); });
+		if(level == KernelLevel::KERNEL_SCALAR)
+			scalar_count = num_counted;
+		all_match = all_match && (num_counted == scalar_count) && (num_scanned == scalar_count) &&
+		            (num_sparse == sparse_map.countTraversable());
+
+		pass_ms[6][level] = timePass([&]() { AStar a_star(game_map, start, goal); });
+	}
+	setKernelLevel(best_level);
+
+	cout << "\t" << game_map.countTraversable() << " traversable tiles, levels "
+	     << (all_match ? "agree" : "DISAGREE") << " on every result" << endl;
+	for(unsigned int pass_idx = 0; pass_idx < num_passes; ++pass_idx)
+	{
+		cout << "\t" << pass_names[pass_idx] << ":";
+		for(int level = KernelLevel::KERNEL_SCALAR; level <= best_level; ++level)
+			cout << " " << getKernelLevelName((KernelLevel::Type)level) << " " << pass_ms[pass_idx][level] << " ms";
+		cout << ", speed-up " << pass_ms[pass_idx][KernelLevel::KERNEL_SCALAR] / pass_ms[pass_idx][best_level]
+		     << "x" << endl;
+	}
+}
+
+// Map snapshot benchmark
+void benchSnapshots(const GameMap &game_map, unsigned int num_searches, unsigned int block_size)
+{
+	vector<PosTile> starts, goals;
+	pickFreeTiles(game_map, num_searches, 1, starts);
+	pickFreeTiles(game_map, num_searches, 2, goals);
+	num_searches = min(starts.size(), goals.size());
+
+	long base_pages = GameMap::getNumLivePages();
+	VersionedMap versioned_map(game_map);
+	unsigned int num_pages = game_map.getNumPages();
+
+	// Readers: each search takes the current snapshot and runs on it to the end
+	atomic<unsigned int> next_search(0), num_finished(0), num_covered(0), num_found(0), num_valid(0), num_stale(0);
+	auto runSearches = [&]()
+	{
+		for(unsigned int search_idx = next_search++; search_idx < num_searches; search_idx = next_search++)
+		{
+			// Skip queries whose start or goal is under an obstacle block right now
+			shared_ptr<const GameMap> snapshot = versioned_map.acquire();
+			if(!snapshot->getTraversable(starts[search_idx].x, starts[search_idx].y) ||
+			   !snapshot->getTraversable(goals[search_idx].x, goals[search_idx].y))
+			{
+				++num_covered;
+				++num_finished;
+				continue;
+			}
+
+			AStar a_star(snapshot, starts[search_idx], goals[search_idx]);
+			while(a_star.advance(SNAPSHOT_BENCH_SLICE) == SearchStatus::SEARCH_RUNNING)
+				;
+			++num_finished;
+			if(a_star.getStatus() != SearchStatus::SEARCH_FOUND)
+				continue;
+			++num_found;
+
+			// The path must be valid on its own snapshot; it may already be blocked in the latest one
+			vector<PosTile> path;
+			a_star.getPath(path);
+			shared_ptr<const GameMap> latest = versioned_map.acquire();
+			bool valid = true, stale = false;
+			for(unsigned int tile_idx = 0; tile_idx < path.size(); ++tile_idx)
+			{
+				valid = valid && snapshot->getTraversable(path[tile_idx].x, path[tile_idx].y);
+				stale = stale || !latest->getTraversable(path[tile_idx].x, path[tile_idx].y);
+			}
+			num_valid += valid ? 1 : 0;
+			num_stale += stale ? 1 : 0;
+		}
+	};
+
+	// Writer: adds a random obstacle block, then clears it again, until the searches finish
+	unsigned int num_updates = 0, num_pages_replaced = 0;
+	long peak_pages = 0;
+	double update_seconds = 0.0;
+	auto runUpdates = [&]()
+	{
+		unsigned long long seed = 3;
+		vector<PosTile> block;
+		while(num_finished < num_searches)
+		{
+			if(num_updates % 2 == 0)
+			{
+				PosTile corner = { (unsigned int)(nextRandom(seed) % game_map.getWidth()),
+				                   (unsigned int)(nextRandom(seed) % game_map.getHeight()) };
+				block.clear();
+				for(unsigned int y = corner.y; y < min(corner.y + block_size, game_map.getHeight()); ++y)
+					for(unsigned int x = corner.x; x < min(corner.x + block_size, game_map.getWidth()); ++x)
+						block.push_back(PosTile{ x, y });
+			}
+
+			shared_ptr<const GameMap> old_map = versioned_map.acquire();
+			chrono::steady_clock::time_point begin_time = chrono::steady_clock::now();
+			shared_ptr<const GameMap> new_map = versioned_map.updateObstacles(block, num_updates % 2 == 1);
+			update_seconds += chrono::duration<double>(chrono::steady_clock::now() - begin_time).count();
+
+			num_pages_replaced += num_pages - new_map->countSharedPages(*old_map);
+			peak_pages = max(peak_pages, GameMap::getNumLivePages() - base_pages);
+			++num_updates;
+		}
+	};
+
+	chrono::steady_clock::time_point begin_time = chrono::steady_clock::now();
+	vector<thread> workers;
+	unsigned int num_readers = getNumWorkers();
+	for(unsigned int reader_idx = 0; reader_idx < num_readers; ++reader_idx)
+		workers.push_back(thread(runSearches));
+	workers.push_back(thread(runUpdates));
+	for(unsigned int worker_idx = 0; worker_idx < workers.size(); ++worker_idx)
+		workers[worker_idx].join();
+	double seconds = chrono::duration<double>(chrono::steady_clock::now() - begin_time).count();
+
+	// Every old version is gone now; only the current one's new pages should be left
+	shared_ptr<const GameMap> final_map = versioned_map.acquire();
+	long expected_pages = final_map->getNumPages() - final_map->countSharedPages(game_map);
+	long live_pages = GameMap::getNumLivePages() - base_pages;
+
+	cout << "Map snapshots: " << num_pages << " pages of " << MAP_PAGE_ROWS << " rows, " << num_readers
+	     << " search threads, 1 update thread (" << block_size << "x" << block_size << " blocks)" << endl;
+	cout << "\tsearches: " << num_found << "/" << num_searches << " found (" << num_covered
+	     << " skipped, start or goal blocked), " << num_valid
+	     << " valid on their snapshot, " << num_stale << " blocked by a later version, "
+	     << seconds*1000.0 << " ms" << endl;
+	cout << "\tupdates published: " << num_updates << ", "
+	     << ((num_updates > 0) ? update_seconds*1000.0 / num_updates : 0.0) << " ms each, "
+	     << ((num_updates > 0) ? (double)num_pages_replaced / num_updates : 0.0) << "/" << num_pages
+	     << " pages copied per update" << endl;
+	cout << "\tpages alive: peak " << peak_pages << " new, after the run " << live_pages << " (expected "
+	     << expected_pages << ", old versions " << ((live_pages == expected_pages) ? "reclaimed" : "LEAKED")
+	     << ")" << endl;
+}
+
+// Search allocation benchmark
+void benchAlloc(const GameMap &game_map, unsigned int num_queries)
+{
+	vector<PosTile> starts, goals;
+	pickFreeTiles(game_map, num_queries, 1, starts);
+	pickFreeTiles(game_map, num_queries, 2, goals);
+	num_queries = min(starts.size(), goals.size());
+	if(num_queries == 0)
+		return;
+
+	// Run every query on one memory resource, returning its found count
+	size_t max_open_size = 0;
+	auto runQueries = [&](pmr::memory_resource *memory, SearchArena *arena, double &seconds, uint64_t &num_allocs)
+	{
+		unsigned int num_found = 0;
+		uint64_t begin_allocs = memGetAllocCount(MemSubsystem::MEM_SEARCH);
+		chrono::steady_clock::time_point begin_time = chrono::steady_clock::now();
+		for(unsigned int query_idx = 0; query_idx < num_queries; ++query_idx)
+		{
+			if(arena != NULL)
+				arena->reset();
+			AStar a_star(game_map, starts[query_idx], goals[query_idx], 0.0f, memory);
+			while(a_star.advance(10000) == SearchStatus::SEARCH_RUNNING)
+				;
+			num_found += (a_star.getStatus() == SearchStatus::SEARCH_FOUND) ? 1 : 0;
+			max_open_size = max(max_open_size, a_star.getMaxOpenSize());
+		}
+		seconds = chrono::duration<double>(chrono::steady_clock::now() - begin_time).count();
+		num_allocs = memGetAllocCount(MemSubsystem::MEM_SEARCH) - begin_allocs;
+		return num_found;
+	};
+
+	double heap_seconds = 0.0, arena_seconds = 0.0;
+	uint64_t heap_allocs = 0, arena_allocs = 0;
+	unsigned int heap_found = runQueries(pmr::get_default_resource(), NULL, heap_seconds, heap_allocs);
+	SearchArena arena;
+	unsigned int arena_found = runQueries(&arena, &arena, arena_seconds, arena_allocs);
+
+	cout << "Search allocation: " << num_queries << " AStar queries (" << game_map.getWidth() << ","
+	     << game_map.getHeight() << "), " << heap_found << "/" << arena_found << " found, largest Open list "
+	     << max_open_size << " entries" << endl;
+	cout << "\theap:  " << heap_seconds*1000.0 / num_queries << " ms per query";
+	if(MEM_PROFILE)
+		cout << ", " << (double)heap_allocs / num_queries << " heap allocations per query";
+	cout << endl;
+	cout << "\tarena: " << arena_seconds*1000.0 / num_queries << " ms per query";
+	if(MEM_PROFILE)
+		cout << ", " << (double)arena_allocs / num_queries << " heap allocations per query";
+	cout << " (" << arena.getNumHeapAllocs() << " blocks allocated in total, " << arena.getCapacity()
+	     << " bytes, peak use " << arena.getPeak() << " bytes)" << endl;
+	if(!MEM_PROFILE)
+		cout << "\t(set MEM_PROFILE to '1' to count heap allocations)" << endl;
+}
+
+// Search scheduler benchmark
+void benchScheduler(const GameMap &game_map, unsigned int num_searches, unsigned long quantum)
+{
+	vector<PosTile> starts, goals;
+	pickFreeTiles(game_map, num_searches, 1, starts);
+	pickFreeTiles(game_map, num_searches, 2, goals);
+	num_searches = min(starts.size(), goals.size());
+	if(num_searches == 0)
+		return;
+
+	// Standalone: each query runs to the end on its own
+	vector<SearchStatus::Type> statuses(num_searches);
+	vector<vector<PosTile> > paths(num_searches);
+	unsigned int num_found = 0;
+	chrono::steady_clock::time_point begin_time = chrono::steady_clock::now();
+	for(unsigned int search_idx = 0; search_idx < num_searches; ++search_idx)
+	{
+		AStar a_star(game_map, starts[search_idx], goals[search_idx]);
+		while(a_star.advance(10000) == SearchStatus::SEARCH_RUNNING)
+			;
+		statuses[search_idx] = a_star.getStatus();
+		if(statuses[search_idx] == SearchStatus::SEARCH_FOUND)
+		{
+			a_star.getPath(paths[search_idx]);
+			++num_found;
+		}
+	}
+	double standalone_seconds = chrono::duration<double>(chrono::steady_clock::now() - begin_time).count();
+
+	// Interleaved: all queries at once, one quantum each per slice (use_run_until false) or
+	// as many quanta as fit before each tick's deadline (use_run_until true)
+	double longest_step = 0.0;
+	auto runInterleaved = [&](bool use_run_until, unsigned int &num_steps, unsigned int &num_same)
+	{
+		vector<unique_ptr<AStar> > searches;
+		SearchScheduler scheduler(quantum);
+		for(unsigned int search_idx = 0; search_idx < num_searches; ++search_idx)
+		{
+			searches.push_back(unique_ptr<AStar>(new AStar(game_map, starts[search_idx], goals[search_idx])));
+			scheduler.addSearch(searches.back().get());
+		}
+
+		num_steps = 0;
+		longest_step = 0.0;
+		chrono::steady_clock::time_point run_time = chrono::steady_clock::now();
+		unsigned int num_active = scheduler.getNumActive();
+		while(num_active > 0)
+		{
+			chrono::steady_clock::time_point step_time = chrono::steady_clock::now();
+			if(use_run_until)
+				num_active = scheduler.runUntil(step_time + chrono::milliseconds(1));
+			else
+				num_active = scheduler.runSlice();
+			longest_step = max(longest_step, chrono::duration<double>(chrono::steady_clock::now() - step_time).count());
+			++num_steps;
+		}
+		double seconds = chrono::duration<double>(chrono::steady_clock::now() - run_time).count();
+
+		// Each search must end exactly as it did standalone
+		num_same = 0;
+		vector<PosTile> path;
+		for(unsigned int search_idx = 0; search_idx < num_searches; ++search_idx)
+		{
+			path.clear();
+			if(searches[search_idx]->getStatus() == SearchStatus::SEARCH_FOUND)
+				searches[search_idx]->getPath(path);
+			bool same = (searches[search_idx]->getStatus() == statuses[search_idx] &&
+			             path.size() == paths[search_idx].size());
+			for(unsigned int tile_idx = 0; same && tile_idx < path.size(); ++tile_idx)
+				same = (path[tile_idx].x == paths[search_idx][tile_idx].x &&
+				        path[tile_idx].y == paths[search_idx][tile_idx].y);
+			num_same += same ? 1 : 0;
+		}
+		return seconds;
+	};
+
+	unsigned int num_slices = 0, slice_same = 0, num_ticks = 0, tick_same = 0;
+	double slice_seconds = runInterleaved(false, num_slices, slice_same);
+	double longest_slice = longest_step;
+	double tick_seconds = runInterleaved(true, num_ticks, tick_same);
+	double longest_tick = longest_step;
+
+	cout << "Search scheduler: " << num_searches << " AStar searches (" << game_map.getWidth() << ","
+	     << game_map.getHeight() << "), " << num_found << " found, quantum " << quantum << " expansions" << endl;
+	cout << "\tstandalone:  " << standalone_seconds*1000.0 << " ms" << endl;
+	cout << "\trunSlice():  " << slice_seconds*1000.0 << " ms, " << num_slices << " slices (longest "
+	     << longest_slice*1000.0 << " ms), " << slice_same << "/" << num_searches << " same as standalone" << endl;
+	cout << "\trunUntil():  " << tick_seconds*1000.0 << " ms, " << num_ticks << " 1 ms ticks (longest "
+	     << longest_tick*1000.0 << " ms), " << tick_same << "/" << num_searches << " same as standalone" << endl;
+}
+
+// Path cache benchmark
+void benchCache(GameMap &game_map, unsigned int num_lookups, unsigned int num_queries, unsigned int update_every,
+                size_t max_bytes)
+{
+	vector<PosTile> starts, goals;
+	pickFreeTiles(game_map, num_queries, 1, starts);
+	pickFreeTiles(game_map, num_queries, 2, goals);
+	num_queries = min(starts.size(), goals.size());
+	if(num_queries == 0)
+		return;
+
+	// Obstacle blocks never cover a query's start or goal
+	set<pair<unsigned int, unsigned int> > ends;
+	for(unsigned int query_idx = 0; query_idx < num_queries; ++query_idx)
+	{
+		ends.insert(make_pair(starts[query_idx].x, starts[query_idx].y));
+		ends.insert(make_pair(goals[query_idx].x, goals[query_idx].y));
+	}
+
+	PathCache path_cache(max_bytes);
+	unsigned long long seed = 3;
+	unsigned int num_hits = 0, num_misses = 0, num_updates = 0, num_blocked = 0;
+	double hit_seconds = 0.0, longest_hit = 0.0, miss_seconds = 0.0, update_seconds = 0.0;
+	uint64_t miss_allocs = 0;
+	vector<PosTile> block;
+	shared_ptr<const vector<PosTile> > path;
+	for(unsigned int lookup_idx = 0; lookup_idx < num_lookups; ++lookup_idx)
+	{
+		// Every 'update_every' lookups, add a random obstacle block, or clear the last one again
+		if(update_every > 0 && lookup_idx > 0 && lookup_idx % update_every == 0)
+		{
+			bool traversable = (num_updates % 2 == 1);
+			if(!traversable)
+			{
+				PosTile corner = { (unsigned int)(nextRandom(seed) % game_map.getWidth()),
+				                   (unsigned int)(nextRandom(seed) % game_map.getHeight()) };
+				block.clear();
+				for(unsigned int y = corner.y; y < min(corner.y + CACHE_BENCH_BLOCK, game_map.getHeight()); ++y)
+					for(unsigned int x = corner.x; x < min(corner.x + CACHE_BENCH_BLOCK, game_map.getWidth()); ++x)
+						if(game_map.getTraversable(x, y) && ends.count(make_pair(x, y)) == 0)
+							block.push_back(PosTile{ x, y });
+			}
+
+			unsigned long old_version = game_map.getVersion();
+			game_map.updateObstacles(block, traversable);
+			chrono::steady_clock::time_point update_time = chrono::steady_clock::now();
+			path_cache.onObstacleUpdate(old_version, game_map.getVersion(), block, traversable);
+			update_seconds += chrono::duration<double>(chrono::steady_clock::now() - update_time).count();
+			++num_updates;
+		}
+
+		// Look up a random query of the set
+		unsigned int query_idx = nextRandom(seed) % num_queries;
+		unsigned long begin_hits = path_cache.getStats().hits;
+		uint64_t begin_allocs = memGetAllocCount(MemSubsystem::MEM_SEARCH);
+		chrono::steady_clock::time_point lookup_time = chrono::steady_clock::now();
+		path_cache.findPath(game_map, starts[query_idx], goals[query_idx], 0.0f, path);
+		double seconds = chrono::duration<double>(chrono::steady_clock::now() - lookup_time).count();
+		if(path_cache.getStats().hits == begin_hits)
+		{
+			miss_allocs += memGetAllocCount(MemSubsystem::MEM_SEARCH) - begin_allocs;
+			miss_seconds += seconds;
+			++num_misses;
+			continue;
+		}
+		hit_seconds += seconds;
+		longest_hit = max(longest_hit, seconds);
+		++num_hits;
+
+		// A cached path must still be clear on the current map
+		bool blocked = false;
+		for(unsigned int tile_idx = 0; !blocked && tile_idx < path->size(); ++tile_idx)
+			blocked = !game_map.getTraversable((*path)[tile_idx].x, (*path)[tile_idx].y);
+		num_blocked += blocked ? 1 : 0;
+	}
+
+	cout << "Path cache: " << num_lookups << " lookups of " << num_queries << " queries (" << game_map.getWidth()
+	     << "," << game_map.getHeight() << "), a " << CACHE_BENCH_BLOCK << "x" << CACHE_BENCH_BLOCK
+	     << " obstacle block added or cleared every " << update_every << " lookups" << endl;
+	cout << "\thits:    " << num_hits << " (" << 100.0*num_hits / num_lookups << "%), "
+	     << ((num_hits > 0) ? hit_seconds*1.0e6 / num_hits : 0.0) << " us each (longest "
+	     << longest_hit*1.0e6 << " us), " << num_blocked << " blocked on the current map" << endl;
+	cout << "\tmisses:  " << num_misses << ", " << ((num_misses > 0) ? miss_seconds*1000.0 / num_misses : 0.0)
+	     << " ms each";
+	if(MEM_PROFILE)
+		cout << ", " << ((num_misses > 0) ? (double)miss_allocs / num_misses : 0.0) << " search heap allocations each";
+	cout << endl;
+	cout << "\tupdates: " << num_updates << ", onObstacleUpdate() "
+	     << ((num_updates > 0) ? update_seconds*1.0e6 / num_updates : 0.0) << " us each" << endl;
+	path_cache.printStats(cout);
+}
+
+// Low-memory engine benchmark
+void benchFringe(const vector<string> &map_files, size_t max_bytes)
+{
+	// Check a path step by step, returning its cost (-1 if it isn't a valid path)
+	auto checkPath = [](const GameMap &game_map, const vector<PosTile> &path, const PosTile &start, const PosTile &end)
+	{
+		if(path.empty() || path.front().x != start.x || path.front().y != start.y ||
+		   path.back().x != end.x || path.back().y != end.y)
+			return -1.0f;
+		for(unsigned int tile_idx = 0; tile_idx < path.size(); ++tile_idx)
+		{
+			if(!game_map.getTraversable(path[tile_idx].x, path[tile_idx].y))
+				return -1.0f;
+			if(tile_idx > 0 && (abs((int)path[tile_idx].x - (int)path[tile_idx - 1].x) > 1 ||
+			                    abs((int)path[tile_idx].y - (int)path[tile_idx - 1].y) > 1))
+				return -1.0f;
+		}
+		return pathCost(path);
+	};
+
+	const char *status_names[SearchStatus::NUM_STATUSES] = { "time limit", "found", "unreachable", "cancelled",
+	                                                         "memory cap" };
+	vector<string> report;
+	for(unsigned int file_idx = 0; file_idx < map_files.size(); ++file_idx)
+	{
+		GameMap game_map;
+		PosTile start, end;
+		if(!game_map.loadFile(map_files[file_idx], start, end))
+		{
+			report.push_back(map_files[file_idx] + ": failed to load, skipped");
+			continue;
+		}
+		stringstream map_report;
+		map_report << map_files[file_idx] << " (" << game_map.getWidth() << "," << game_map.getHeight() << ")";
+
+		// AStar, in an arena so its search memory can be measured exactly
+		vector<PosTile> path;
+		SearchArena arena;
+		chrono::steady_clock::time_point begin_time = chrono::steady_clock::now();
+		SearchStatus::Type astar_status;
+		unsigned long astar_expansions;
+		{
+			AStar a_star(game_map, start, end, 0.0f, &arena);
+			a_star.advanceUntil(begin_time + chrono::seconds(FRINGE_BENCH_ASTAR_SECONDS));
+			astar_status = a_star.getStatus();
+			astar_expansions = a_star.getIterationNum();
+			if(astar_status == SearchStatus::SEARCH_FOUND)
+				a_star.getPath(path);
+		}
+		double astar_ms = chrono::duration<double, milli>(chrono::steady_clock::now() - begin_time).count();
+		float astar_cost = (astar_status == SearchStatus::SEARCH_FOUND) ? checkPath(game_map, path, start, end) : 0.0f;
+
+		// FringeSearch
+		begin_time = chrono::steady_clock::now();
+		FringeSearch fringe_search(game_map, start, end, 0.0f, max_bytes);
+		while(fringe_search.advance(10000) == SearchStatus::SEARCH_RUNNING)
+			;
+		double fringe_ms = chrono::duration<double, milli>(chrono::steady_clock::now() - begin_time).count();
+		SearchStatus::Type fringe_status = fringe_search.getStatus();
+		float fringe_cost = 0.0f;
+		if(fringe_status == SearchStatus::SEARCH_FOUND)
+		{
+			fringe_search.getPath(path);
+			fringe_cost = checkPath(game_map, path, start, end);
+		}
+
+		map_report << endl << "\tAStar:  " << status_names[astar_status] << ", cost " << astar_cost << ", "
+		           << astar_expansions << " expanded, " << astar_ms << " ms, " << arena.getPeak() / 1024 << " kB";
+		map_report << endl << "\tfringe: " << status_names[fringe_status] << ", cost " << fringe_cost << ", "
+		           << fringe_search.getIterationNum() << " expanded, " << fringe_search.getNumThresholds()
+		           << " thresholds, " << fringe_ms << " ms, " << fringe_search.getPeakBytes() / 1024 << " kB ("
+		           << fringe_search.getNumReached() << " tiles reached"
+		           << (fringe_search.isCacheDense() ? ", G plane)" : ", G hash)");
+		report.push_back(map_report.str());
+	}
+
+	cout << "Low-memory engine: FringeSearch capped at " << max_bytes / 1024 << " kB (cost -1 = invalid path)" << endl;
+	for(unsigned int line_idx = 0; line_idx < report.size(); ++line_idx)
+		cout << report[line_idx] << endl;
+}
+
+// Map loading benchmark
+void benchLoad(const vector<string> &map_files, unsigned int reps)
+{
+	GameMap first_map;
+	bool have_first = false;
+	vector<string> report;
+	for(unsigned int file_idx = 0; file_idx < map_files.size(); ++file_idx)
+	{
+		GameMap game_map;
+		PosTile start, end;
+		double best_ms = 0.0;
+		bool loaded = true;
+		for(unsigned int rep_idx = 0; rep_idx < reps && loaded; ++rep_idx)
+		{
+			chrono::steady_clock::time_point begin_time = chrono::steady_clock::now();
+			loaded = game_map.loadFile(map_files[file_idx], start, end);
+			double load_ms = chrono::duration<double, milli>(chrono::steady_clock::now() - begin_time).count();
+			if(rep_idx == 0 || load_ms < best_ms)
+				best_ms = load_ms;
+		}
+		if(!loaded)
+		{
+			report.push_back(map_files[file_idx] + ": failed to load, skipped");
+			continue;
+		}
+
+		// Compare every tile with the first map loaded
+		bool same = true;
+		if(!have_first)
+		{
+			first_map = game_map;
+			have_first = true;
+		}
+		else if(game_map.getWidth() != first_map.getWidth() || game_map.getHeight() != first_map.getHeight())
+			same = false;
+		for(unsigned int row_idx = 0; row_idx < game_map.getHeight() && same; ++row_idx)
+		{
+			for(unsigned int col_idx = 0; col_idx < game_map.getWidth() && same; ++col_idx)
+				same = (game_map.getTraversable(col_idx, row_idx) == first_map.getTraversable(col_idx, row_idx));
+		}
+
+		stringstream map_report;
+		map_report << map_files[file_idx] << " (" << game_map.getWidth() << "," << game_map.getHeight() << "): "
+		           << best_ms << " ms" << (same ? "" : ", DIFFERENT map from the first file");
+		report.push_back(map_report.str());
+	}
+
+	cout << "Map loading: best of " << reps << " loads, " << getNumWorkers() << " worker thread(s)" << endl;
+	for(unsigned int line_idx = 0; line_idx < report.size(); ++line_idx)
+		cout << report[line_idx] << endl;
+}
+
+// Goal bounding benchmark
+void benchGoalBounds(const GameMap &game_map, const string &map_file_name, unsigned int num_queries)
+{
+	// Load the side file, or build it
+	GoalBounds goal_bounds;
+	string side_file_name = GoalBounds::getSideFileName(map_file_name);
+	chrono::steady_clock::time_point begin_time = chrono::steady_clock::now();
+	bool loaded = goal_bounds.load(side_file_name, game_map);
+	if(!loaded)
+	{
+		if(!goal_bounds.build(game_map))
+		{
+			cout << "Map too large for goal bounds (over " << GOAL_BOUNDS_MAX_TILES << " tiles)" << endl;
+			return;
+		}
+		if(!goal_bounds.save(side_file_name) || !goal_bounds.load(side_file_name, game_map))
+			cout << "Failed to write goal bounds, using them from memory: " << side_file_name << endl;
+	}
+	double prep_seconds = chrono::duration<double>(chrono::steady_clock::now() - begin_time).count();
+
+	vector<PosTile> starts, goals;
+	pickFreeTiles(game_map, num_queries, 1, starts);
+	pickFreeTiles(game_map, num_queries, 2, goals);
+	num_queries = min(starts.size(), goals.size());
+	if(num_queries == 0)
+		return;
+
+	// Run every query, with or without the bounds, returning the found count
+	auto runQueries = [&](bool octile, const GoalBounds *bounds, vector<float> &costs, double &seconds,
+	                      unsigned long &expansions)
+	{
+		unsigned int num_found = 0;
+		expansions = 0;
+		costs.assign(num_queries, -1.0f);
+		vector<PosTile> path;
+		chrono::steady_clock::time_point query_time = chrono::steady_clock::now();
+		for(unsigned int query_idx = 0; query_idx < num_queries; ++query_idx)
+		{
+			AStar a_star(game_map, starts[query_idx], goals[query_idx]);
+			a_star.setOctileHeuristic(octile);
+			a_star.setGoalBounds(bounds);
+			while(a_star.advance(10000) == SearchStatus::SEARCH_RUNNING)
+				;
+			expansions += a_star.getIterationNum();
+			if(a_star.getStatus() == SearchStatus::SEARCH_FOUND)
+			{
+				a_star.getPath(path);
+				costs[query_idx] = pathCost(path);
+				++num_found;
+			}
+		}
+		seconds = chrono::duration<double>(chrono::steady_clock::now() - query_time).count();
+		return num_found;
+	};
+
+	// The bounds keep a shortest path, so only octile A* (which never overestimates) must give the same
+	// costs; Manhattan A* is the default search, and the bounds can find it a shorter path
+	vector<float> manhattan_costs, octile_costs, bounded_costs;
+	double manhattan_seconds = 0.0, octile_seconds = 0.0, bounded_seconds = 0.0;
+	unsigned long manhattan_expansions = 0, octile_expansions = 0, bounded_expansions = 0;
+	unsigned int manhattan_found = runQueries(false, NULL, manhattan_costs, manhattan_seconds, manhattan_expansions);
+	unsigned int octile_found = runQueries(true, NULL, octile_costs, octile_seconds, octile_expansions);
+	unsigned int bounded_found = runQueries(true, &goal_bounds, bounded_costs, bounded_seconds, bounded_expansions);
+
+	// Count the bounded costs that are the same as, shorter or longer than another run's
+	auto compareCosts = [&](const vector<float> &other_costs, const char *other_name)
+	{
+		unsigned int num_same = 0, num_shorter = 0, num_longer = 0;
+		for(unsigned int query_idx = 0; query_idx < num_queries; ++query_idx)
+		{
+			if(fabs(bounded_costs[query_idx] - other_costs[query_idx]) < 1.0e-3f)
+				++num_same;
+			else if(bounded_costs[query_idx] < other_costs[query_idx])
+				++num_shorter;
+			else
+				++num_longer;
+		}
+		cout << "\tpath cost with bounds vs " << other_name << ": " << num_same << " same, " << num_shorter
+		     << " shorter, " << num_longer << " longer" << endl;
+	};
+
+	cout << "Goal bounds (" << game_map.getWidth() << "," << game_map.getHeight() << "): "
+	     << (loaded ? "loaded " : "built and saved ") << side_file_name << " in " << prep_seconds << " s ("
+	     << goal_bounds.getNumBytes() / 1024 << " kB, " << (goal_bounds.isMapped() ? "memory-mapped" : "in memory")
+	     << ", " << getNumWorkers() << " worker thread(s))" << endl;
+	cout << "\t" << num_queries << " AStar queries, found: Manhattan " << manhattan_found << ", octile "
+	     << octile_found << ", octile with bounds " << bounded_found << endl;
+	cout << "\tManhattan:           " << (double)manhattan_expansions / num_queries << " expanded, "
+	     << manhattan_seconds*1000.0 / num_queries << " ms per query" << endl;
+	cout << "\toctile:              " << (double)octile_expansions / num_queries << " expanded, "
+	     << octile_seconds*1000.0 / num_queries << " ms per query" << endl;
+	cout << "\toctile with bounds:  " << (double)bounded_expansions / num_queries << " expanded, "
+	     << bounded_seconds*1000.0 / num_queries << " ms per query" << endl;
+
+	// Weigh the speedup against the build time (a load is not a build)
+	double saved_seconds = (octile_seconds - bounded_seconds) / num_queries;
+	cout << "\tspeedup over octile: " << (double)octile_expansions / max(bounded_expansions, 1UL)
+	     << "x fewer expanded, " << octile_seconds / max(bounded_seconds, 1.0e-9) << "x faster; ";
+	if(loaded)
+		cout << "build not timed (side file loaded)" << endl;
+	else if(saved_seconds > 0.0)
+		cout << "build " << prep_seconds << " s = the time saved over " << (unsigned long)ceil(prep_seconds / saved_seconds)
+		     << " queries" << endl;
+	else
+		cout << "build " << prep_seconds << " s, never paid back" << endl;
+	compareCosts(octile_costs, "octile");
+	compareCosts(manhattan_costs, "Manhattan");
+}
+
+// Tie-break benchmark
+void benchTieBreak(const vector<string> &map_files)
+{
+	// Orders to run: the original sort, the tile-index order sorted and then as a heap (same expansions,
+	// so the difference is the heap's), then the H and G orders as a heap (their difference from the
+	// tile-index heap is the tie-break's)
+	struct TieMode
+	{
+		const char *name;
+		TieBreak::Type tie_break;
+		bool open_heap;
+	};
+	const TieMode tie_modes[] = { { "F only, sorted", TieBreak::TIE_NONE, false },
+	                              { "tile index, sorted", TieBreak::TIE_INDEX, false },
+	                              { "tile index, heap", TieBreak::TIE_INDEX, true },
+	                              { "lower H, heap", TieBreak::TIE_LOW_H, true },
+	                              { "higher G, heap", TieBreak::TIE_HIGH_G, true } };
+	const unsigned int num_tie_modes = sizeof(tie_modes) / sizeof(tie_modes[0]);
+	const char *status_names[SearchStatus::NUM_STATUSES] = { "time limit", "found", "unreachable", "cancelled",
+	                                                         "memory cap" };
+
+	// One search's results
+	struct TieRun
+	{
+		SearchStatus::Type status;
+		unsigned long expansions;
+		size_t max_open_size;
+		double ms;
+		vector<PosTile> path;
+	};
+	auto runSearch = [](const GameMap &game_map, const PosTile &start, const PosTile &end,
+	                    const TieMode &tie_mode, TieRun &run)
+	{
+		chrono::steady_clock::time_point begin_time = chrono::steady_clock::now();
+		AStar a_star(game_map, start, end);
+		a_star.setTieBreak(tie_mode.tie_break);
+		a_star.setOpenHeap(tie_mode.open_heap);
+		a_star.advanceUntil(begin_time + chrono::seconds(TIE_BENCH_ASTAR_SECONDS));
+		run.ms = chrono::duration<double, milli>(chrono::steady_clock::now() - begin_time).count();
+		run.status = a_star.getStatus();
+		run.expansions = a_star.getIterationNum();
+		run.max_open_size = a_star.getMaxOpenSize();
+		run.path.clear();
+		if(run.status == SearchStatus::SEARCH_FOUND)
+			a_star.getPath(run.path);
+	};
+
+	vector<string> report;
+	for(unsigned int file_idx = 0; file_idx < map_files.size(); ++file_idx)
+	{
+		GameMap game_map;
+		PosTile start, end;
+		if(!game_map.loadFile(map_files[file_idx], start, end))
+		{
+			report.push_back(map_files[file_idx] + ": failed to load, skipped");
+			continue;
+		}
+		stringstream map_report;
+		map_report << map_files[file_idx] << " (" << game_map.getWidth() << "," << game_map.getHeight() << ")";
+
+		for(unsigned int mode_idx = 0; mode_idx < num_tie_modes; ++mode_idx)
+		{
+			TieRun first_run, thread_run;
+			runSearch(game_map, start, end, tie_modes[mode_idx], first_run);
+			thread search_thread(runSearch, cref(game_map), cref(start), cref(end), cref(tie_modes[mode_idx]),
+			                     ref(thread_run));
+			search_thread.join();
+
+			// The runs agree if they expanded as many tiles and found the same tiles
+			bool same = (first_run.status == thread_run.status && first_run.expansions == thread_run.expansions &&
+			             first_run.path.size() == thread_run.path.size());
+			for(unsigned int tile_idx = 0; tile_idx < first_run.path.size() && same; ++tile_idx)
+				same = (first_run.path[tile_idx].x == thread_run.path[tile_idx].x &&
+				        first_run.path[tile_idx].y == thread_run.path[tile_idx].y);
+
+			map_report << endl << "\t" << tie_modes[mode_idx].name << ": " << status_names[first_run.status] << ", cost "
+			           << pathCost(first_run.path) << ", " << first_run.expansions << " expanded, Open list up to "
+			           << first_run.max_open_size << ", " << first_run.ms << " ms, "
+			           << ((first_run.status == SearchStatus::SEARCH_RUNNING) ? "stopped (not compared)"
+			                                                                   : (same ? "same on another thread"
+			                                                                           : "DIFFERENT on another thread"));
+		}
+		report.push_back(map_report.str());
+	}
+
+	cout << "Tie-break orders: each map's own query, AStar stopped after " << TIE_BENCH_ASTAR_SECONDS << " s" << endl;
+	for(unsigned int line_idx = 0; line_idx < report.size(); ++line_idx)
+		cout << report[line_idx] << endl;
+}
+
+// Clearance check against brute force
+bool benchClearance(unsigned int width, unsigned int height, double density)
+{
+	MapGenerator generator(width, height, 1);
+	generator.generate(MapTopology::TOPO_RANDOM, density);
+	const vector<uint64_t> &obstacle_words = generator.getObstacleWords();
+	size_t row_words = (width + MAP_WORD_BITS - 1) / MAP_WORD_BITS;
+
+	chrono::steady_clock::time_point begin_time = chrono::steady_clock::now();
+	GameMap game_map(obstacle_words, width, height);
+	double build_ms = chrono::duration<double, milli>(chrono::steady_clock::now() - begin_time).count();
+
+	// Distance (in columns) from each tile to the nearest obstacle in its own row (-1 if none)
+	vector<int64_t> row_dist((size_t)width*height, -1);
+	for(unsigned int row_idx = 0; row_idx < height; ++row_idx)
+	{
+		int64_t *dist = &row_dist[(size_t)row_idx*width];
+		int64_t last_obs = -1;
+		for(unsigned int col_idx = 0; col_idx < width; ++col_idx)
+		{
+			if((obstacle_words[row_idx*row_words + col_idx/MAP_WORD_BITS] >> (col_idx%MAP_WORD_BITS)) & 1)
+				last_obs = col_idx;
+			dist[col_idx] = (last_obs < 0) ? -1 : (int64_t)col_idx - last_obs;
+		}
+		last_obs = -1;
+		for(unsigned int col_idx = width; col_idx-- > 0; )
+		{
+			if(dist[col_idx] == 0)
+				last_obs = col_idx;
+			if(last_obs >= 0 && (dist[col_idx] < 0 || last_obs - (int64_t)col_idx < dist[col_idx]))
+				dist[col_idx] = last_obs - (int64_t)col_idx;
+		}
+	}
+
+	// Every tile against the nearest obstacle of every row, in exact integers
+	size_t num_wrong = 0;
+	double max_over = 0.0, max_under = 0.0;
+	for(unsigned int row_idx = 0; row_idx < height; ++row_idx)
+		for(unsigned int col_idx = 0; col_idx < width; ++col_idx)
+		{
+			int64_t best_sq = -1;
+			for(unsigned int obs_row = 0; obs_row < height; ++obs_row)
+			{
+				int64_t col_dist = row_dist[(size_t)obs_row*width + col_idx];
+				if(col_dist < 0)
+					continue;
+				int64_t row_dist_sq = ((int64_t)row_idx - obs_row)*((int64_t)row_idx - obs_row);
+				if(best_sq < 0 || col_dist*col_dist + row_dist_sq < best_sq)
+					best_sq = col_dist*col_dist + row_dist_sq;
+			}
+
+			double exact = (best_sq < 0) ? CLEARANCE_NONE : sqrt((double)best_sq);
+			double error = (double)game_map.getClearance(col_idx, row_idx) - exact;
+			max_over = max(max_over, error);
+			max_under = max(max_under, -error);
+			num_wrong += (fabs(error) > CLEARANCE_BENCH_TOLERANCE) ? 1 : 0;
+		}
+
+	bool passed = (num_wrong == 0);
+	cout << "Clearance: " << width << "x" << height << ", density " << density << ", built in " << build_ms << " ms" << endl;
+	cout << "\tLargest error over brute force: +" << max_over << " / -" << max_under << " tiles" << endl;
+	cout << "\tTiles off by more than " << CLEARANCE_BENCH_TOLERANCE << ": " << num_wrong
+	     << (passed ? " (ok)" : " (FAILED)") << endl;
+	return passed;
+}
@@ -0,0 +1,414 @@
+/**
+ * CooperativePlanner.cpp
+ *  Created on: Oct 18, 2026
+ *      Author: iRobot maintainers
+ *     Purpose: Multi-robot cooperative pathfinding (Windowed Hierarchical Cooperative A*)
+ */
+#include "../headers/CooperativePlanner.hpp"
+#include "../headers/MemProfile.hpp"
+
+#include <unordered_set>
+
+using namespace std;
+
+// Starting SlotTable capacity (power of two)
+#define SLOT_INIT_CAPACITY	1024
+
+// G for tiles the reverse search has not reached yet (above any real distance, CLOSED_FLAG clear)
+#define G_UNSEEN	(~CLOSED_FLAG)
+
+// Moves available to a robot each time step: wait, then the 8 directions
+static const int MOVE_DX[9] = { 0,  0, 1, 1, 1, 0, -1, -1, -1 };
+static const int MOVE_DY[9] = { 0, -1, -1, 0, 1, 1, 1, 0, -1 };
+
+//---------------------------------------------------------------------
+// SlotTable
+//---------------------------------------------------------------------
+// Generic constructor
+SlotTable::SlotTable()
+: keys(SLOT_INIT_CAPACITY, SLOT_EMPTY_KEY), values(SLOT_INIT_CAPACITY, 0), num_slots(0)
+{
+
+}
+
+// Fetch or add a key
+uint32_t &SlotTable::insert(uint64_t key, uint32_t init_value)
+{
+	// Keep the load factor at or below 1/2, so probe sequences stay short
+	if((num_slots + 1)*2 > keys.size())
+		grow();
+
+	size_t slot = findSlot(key);
+	if(keys[slot] == SLOT_EMPTY_KEY)
+	{
+		keys[slot] = key;
+		values[slot] = init_value;
+		++num_slots;
+	}
+	return values[slot];
+}
+
+// Remove every key
+void SlotTable::clear()
+{
+	fill(keys.begin(), keys.end(), SLOT_EMPTY_KEY);
+	num_slots = 0;
+}
+
+// Double the capacity
+void SlotTable::grow()
+{
+	vector<uint64_t> old_keys;
+	vector<uint32_t> old_values;
+	old_keys.swap(keys);
+	old_values.swap(values);
+	keys.assign(old_keys.size()*2, SLOT_EMPTY_KEY);
+	values.assign(old_values.size()*2, 0);
+
+	size_t old_size = old_keys.size();
+	for(size_t slot_idx = 0; slot_idx < old_size; ++slot_idx)
+	{
+		if(old_keys[slot_idx] == SLOT_EMPTY_KEY)
+			continue;
+		size_t slot = findSlot(old_keys[slot_idx]);
+		keys[slot] = old_keys[slot_idx];
+		values[slot] = old_values[slot_idx];
+	}
+}
+
+//---------------------------------------------------------------------
+// ReverseDistance
+//---------------------------------------------------------------------
+// Initialization constructor
+ReverseDistance::ReverseDistance(const GameMap &game_map, const PosTile &goal, const PosTile &start)
+: game_map_ptr(&game_map), start_pos(start), num_expanded(0)
+{
+	uint32_t goal_tile = goal.y*game_map.getWidth() + goal.x;
+	uint32_t goal_H = max(abs((int)goal.x - (int)start.x), abs((int)goal.y - (int)start.y));
+
+	g_vals.insert(goal_tile, 0);
+	ReverseNode goal_node = { 0, goal_tile };
+	open_buckets.resize(goal_H + 1);
+	open_buckets[goal_H].push_back(goal_node);
+	cur_F = goal_H;
+}
+
+// Fetch the distance to the goal
+uint32_t ReverseDistance::getDistance(unsigned int x, unsigned int y)
+{
+	unsigned int map_width = game_map_ptr->getWidth();
+	unsigned int map_height = game_map_ptr->getHeight();
+	uint32_t query_tile = y*map_width + x;
+
+	const uint32_t *query_G = g_vals.find(query_tile);
+	if(query_G != NULL && (*query_G & CLOSED_FLAG))
+		return *query_G & ~CLOSED_FLAG;
+
+	// Resume the reverse search until the query tile is closed
+	while(true)
+	{
+		while(cur_F < open_buckets.size() && open_buckets[cur_F].empty())
+			++cur_F;
+		if(cur_F >= open_buckets.size())
+			break;
+		ReverseNode cur_node = open_buckets[cur_F].back();
+		open_buckets[cur_F].pop_back();
+
+		// Skip stale entries (already closed, or a cheaper route was found later)
+		uint32_t *cur_G = g_vals.find(cur_node.tile);
+		if((*cur_G & CLOSED_FLAG) || *cur_G < cur_node.G)
+			continue;
+		*cur_G |= CLOSED_FLAG;
+		++num_expanded;
+
+		int cur_x = cur_node.tile % map_width;
+		int cur_y = cur_node.tile / map_width;
+		for(unsigned int move_idx = 1; move_idx < 9; ++move_idx)
+		{
+			int new_x = cur_x + MOVE_DX[move_idx];
+			int new_y = cur_y + MOVE_DY[move_idx];
+			if(new_x < 0 || (unsigned int)new_x >= map_width ||
+			   new_y < 0 || (unsigned int)new_y >= map_height ||
+			   !game_map_ptr->getTraversable(new_x, new_y))
+				continue;
+
+			uint32_t new_tile = new_y*map_width + new_x;
+			uint32_t new_G = cur_node.G + 1;
+			uint32_t &old_G = g_vals.insert(new_tile, G_UNSEEN);
+			if((old_G & CLOSED_FLAG) || old_G <= new_G)
+				continue;
+
+			old_G = new_G;
+			uint32_t new_H = max(abs(new_x - (int)start_pos.x), abs(new_y - (int)start_pos.y));
+			ReverseNode new_node = { new_G, new_tile };
+			if(new_G + new_H >= open_buckets.size())
+				open_buckets.resize(new_G + new_H + 1);
+			open_buckets[new_G + new_H].push_back(new_node);
+		}
+
+		if(cur_node.tile == query_tile)
+			return cur_node.G;
+	}
+
+	return DIST_UNREACHABLE;
+}
+
+//---------------------------------------------------------------------
+// CooperativePlanner
+//---------------------------------------------------------------------
+// Open list entry for the space-time search (ordered by F, then by larger G)
+struct TimeOpenEntry
+{
+	uint32_t F, G;
+	int node_idx;
+	bool operator <(const TimeOpenEntry &other) const
+	{
+		return (F != other.F) ? (F > other.F) : (G < other.G);
+	}
+};
+
+// Initialization constructor
+CooperativePlanner::CooperativePlanner(const GameMap &game_map, unsigned int window_arg)
+: game_map_ptr(&game_map), window(max(window_arg, 2u)), num_expanded(0)
+{
+
+}
+
+// Destructor
+CooperativePlanner::~CooperativePlanner()
+{
+
+}
+
+// Add a robot
+unsigned int CooperativePlanner::addRobot(const PosTile &start, const PosTile &goal)
+{
+	RobotPlan new_robot;
+	new_robot.start = start;
+	new_robot.goal = goal;
+	new_robot.path.push_back(start);
+	new_robot.reachable = true;
+
+	robots.push_back(new_robot);
+	distances.push_back(ReverseDistance(*game_map_ptr, goal, start));
+	return robots.size() - 1;
+}
+
+// Plan every robot
+bool CooperativePlanner::planAll(unsigned int max_time)
+{
+	unsigned int num_robots = robots.size();
+	unsigned int commit_steps = window / 2;
+	vector<PosTile> plan;
+
+	// Find robots that can never arrive (goal in another region than the robot)
+	// Checked with region labels, since letting a reverse search exhaust a region is slow
+	if(component_labels.empty())
+		labelComponents();
+	unsigned int map_width = game_map_ptr->getWidth();
+	for(unsigned int robot_idx = 0; robot_idx < num_robots; ++robot_idx)
+	{
+		const PosTile &cur_pos = robots[robot_idx].path.back();
+		const PosTile &goal = robots[robot_idx].goal;
+		robots[robot_idx].reachable = (component_labels[cur_pos.y*map_width + cur_pos.x] ==
+		                               component_labels[goal.y*map_width + goal.x]);
+	}
+
+	for(unsigned int round_idx = 0; ; ++round_idx)
+	{
+		// Robots' paths are all the same length, so the first one gives the current time
+		unsigned int cur_time = (num_robots == 0) ? 0 : robots[0].path.size() - 1;
+
+		// Done if every robot that can arrive is sitting on its goal
+		bool all_done = true;
+		for(unsigned int robot_idx = 0; robot_idx < num_robots && all_done; ++robot_idx)
+		{
+			const PosTile &cur_pos = robots[robot_idx].path.back();
+			all_done = !robots[robot_idx].reachable ||
+			           (cur_pos.x == robots[robot_idx].goal.x && cur_pos.y == robots[robot_idx].goal.y);
+		}
+		if(all_done)
+			return true;
+		if(cur_time >= max_time)
+			return false;
+
+		// Plan each robot for the next window, rotating priority every round
+		// A robot that finds no way through its window waits in place, which is only safe if no robot
+		// planned before it moved into its tile: such robots hold their tile from the start of the
+		// round (as robots that can never arrive always do), and the round is planned again with
+		// every robot that got boxed in during the last pass held
+		vector<bool> held(num_robots);
+		for(unsigned int robot_idx = 0; robot_idx < num_robots; ++robot_idx)
+			held[robot_idx] = !robots[robot_idx].reachable;
+		bool replan = true;
+		while(replan)
+		{
+			replan = false;
+			reservations.clear();
+			for(unsigned int robot_idx = 0; robot_idx < num_robots; ++robot_idx)
+			{
+				robots[robot_idx].path.resize(cur_time + 1);
+				if(!held[robot_idx])
+					continue;
+				const PosTile &cur_pos = robots[robot_idx].path.back();
+				for(unsigned int depth = 0; depth <= window; ++depth)
+					reservations.reserve(cur_pos.x, cur_pos.y, cur_time + depth, robot_idx);
+			}
+
+			for(unsigned int order_idx = 0; order_idx < num_robots; ++order_idx)
+			{
+				unsigned int robot = (order_idx + round_idx) % num_robots;
+				if(!planWindow(robot, cur_time, commit_steps, plan) && !held[robot])
+					held[robot] = replan = true;
+			}
+		}
+	}
+}
+
+// Label connected regions
+void CooperativePlanner::labelComponents()
+{
+	unsigned int map_width = game_map_ptr->getWidth();
+	unsigned int map_height = game_map_ptr->getHeight();
+	component_labels.assign((size_t)map_width*map_height, NO_COMPONENT);
+
+	// Flood fill each unlabelled traversable tile (8-connected, same moves as the robots)
+	// Seeds are found by scanning the rows' traversability words, skipping obstacle runs
+	uint32_t num_labels = 0;
+	vector<uint32_t> stack;
+	for(unsigned int seed_y = 0; seed_y < map_height; ++seed_y)
+	{
+		for(unsigned int seed_x = game_map_ptr->findTraversable(0, seed_y); seed_x < map_width;
+		    seed_x = game_map_ptr->findTraversable(seed_x + 1, seed_y))
+		{
+			uint32_t seed_tile = seed_y*map_width + seed_x;
+			if(component_labels[seed_tile] != NO_COMPONENT)
+				continue;
+
+			component_labels[seed_tile] = num_labels;
+			stack.push_back(seed_tile);
+			while(!stack.empty())
+			{
+				uint32_t cur_tile = stack.back();
+				stack.pop_back();
+				int cur_x = cur_tile % map_width;
+				int cur_y = cur_tile / map_width;
+				for(unsigned int move_idx = 1; move_idx < 9; ++move_idx)
+				{
+					int new_x = cur_x + MOVE_DX[move_idx];
+					int new_y = cur_y + MOVE_DY[move_idx];
+					if(new_x < 0 || (unsigned int)new_x >= map_width ||
+					   new_y < 0 || (unsigned int)new_y >= map_height)
+						continue;
+					uint32_t new_tile = new_y*map_width + new_x;
+					if(component_labels[new_tile] != NO_COMPONENT || !game_map_ptr->getTraversable(new_x, new_y))
+						continue;
+					component_labels[new_tile] = num_labels;
+					stack.push_back(new_tile);
+				}
+			}
+			++num_labels;
+		}
+	}
+}
+
+// Space-time A* for one robot, one window deep
+bool CooperativePlanner::planWindow(unsigned int robot, unsigned int start_time, unsigned int commit_steps,
+                                    vector<PosTile> &plan)
+{
+	MemScope mem_scope(MemSubsystem::MEM_SEARCH);
+	RobotPlan &robot_plan = robots[robot];
+	ReverseDistance &distance = distances[robot];
+	unsigned int map_width = game_map_ptr->getWidth();
+	unsigned int map_height = game_map_ptr->getHeight();
+
+	vector<TimeNode> node_pool;
+	priority_queue<TimeOpenEntry> open_list;
+	unordered_set<uint64_t> closed;
+
+	// Robots that can't arrive are left with an empty open list, so they wait in place
+	// (searching would only exhaust their goal's region)
+	const PosTile &start = robot_plan.path.back();
+	if(robot_plan.reachable)
+	{
+		uint32_t start_H = distance.getDistance(start.x, start.y);
+		TimeNode start_node = { start.x, start.y, 0, 0, start_H, -1 };
+		node_pool.push_back(start_node);
+		TimeOpenEntry start_entry = { start_node.F, 0, 0 };
+		open_list.push(start_entry);
+	}
+
+	int end_idx = -1;
+	size_t max_open_size = 0;
+	while(!open_list.empty())
+	{
+		max_open_size = max(max_open_size, open_list.size());
+		int cur_idx = open_list.top().node_idx;
+		open_list.pop();
+		TimeNode cur_node = node_pool[cur_idx];
+
+		uint64_t cur_key = ((uint64_t)cur_node.depth << 40) | ((uint64_t)cur_node.y << 20) | cur_node.x;
+		if(!closed.insert(cur_key).second)
+			continue;
+		++num_expanded;
+
+		// The window is full: the rest of the route is left to the reverse distance
+		if(cur_node.depth == window)
+		{
+			end_idx = cur_idx;
+			break;
+		}
+
+		unsigned int new_time = start_time + cur_node.depth + 1;
+		bool at_goal = (cur_node.x == robot_plan.goal.x && cur_node.y == robot_plan.goal.y);
+		for(unsigned int move_idx = 0; move_idx < 9; ++move_idx)
+		{
+			int new_x = (int)cur_node.x + MOVE_DX[move_idx];
+			int new_y = (int)cur_node.y + MOVE_DY[move_idx];
+			if(new_x < 0 || (unsigned int)new_x >= map_width ||
+			   new_y < 0 || (unsigned int)new_y >= map_height ||
+			   !game_map_ptr->getTraversable(new_x, new_y))
+				continue;
+
+			// Skip slots claimed by other robots, and head-on swaps with them
+			uint32_t owner = reservations.getOwner(new_x, new_y, new_time);
+			if(owner != NO_ROBOT && owner != robot)
+				continue;
+			uint32_t swap_owner = reservations.getOwner(new_x, new_y, new_time - 1);
+			if(swap_owner != NO_ROBOT && swap_owner != robot &&
+			   reservations.getOwner(cur_node.x, cur_node.y, new_time) == swap_owner)
+				continue;
+
+			uint32_t new_H = distance.getDistance(new_x, new_y);
+			if(new_H == DIST_UNREACHABLE)
+				continue;
+
+			// Every step costs one, except resting on the goal
+			uint32_t new_G = cur_node.G + ((move_idx == 0 && at_goal) ? 0 : 1);
+			TimeNode new_node = { (unsigned int)new_x, (unsigned int)new_y, cur_node.depth + 1,
+			                      new_G, new_G + new_H, cur_idx };
+			node_pool.push_back(new_node);
+			TimeOpenEntry new_entry = { new_node.F, new_G, (int)node_pool.size() - 1 };
+			open_list.push(new_entry);
+		}
+	}
+
+	memRecordOpenList("CooperativePlanner", max_open_size, sizeof(TimeOpenEntry));
+
+	// Read the window back out (wait in place if the robot is boxed in)
+	plan.assign(window + 1, start);
+	for(int node_idx = end_idx; node_idx >= 0; node_idx = node_pool[node_idx].parent)
+	{
+		PosTile tile = { node_pool[node_idx].x, node_pool[node_idx].y };
+		plan[node_pool[node_idx].depth] = tile;
+	}
+
+	// Swap any hold on the start tile for the whole window's plan, but only commit the first part of it
+	for(unsigned int depth = 0; depth <= window; ++depth)
+		reservations.release(start.x, start.y, start_time + depth, robot);
+	for(unsigned int depth = 0; depth <= window; ++depth)
+		reservations.reserve(plan[depth].x, plan[depth].y, start_time + depth, robot);
+	for(unsigned int depth = 1; depth <= commit_steps; ++depth)
+		robot_plan.path.push_back(plan[depth]);
+	return (end_idx >= 0);
+}
@@ -0,0 +1,287 @@
+/**
+ * FringeSearch.cpp
+ *  Created on: Oct 18, 2026
+ *      Author: iRobot maintainers
+ *     Purpose: Low-memory path engine (fringe search)
+ *              See: Bjornsson, Enzenberger, Holte, Schaeffer, "Fringe Search: Beating A* at Pathfinding
+ *              on Game Maps" (2005)
+ */
+#include "../headers/FringeSearch.hpp"
+#include "../headers/MemProfile.hpp"
+
+using namespace std;
+
+// Tile offsets of the MoveDir directions
+static const int DIR_DX[MoveDir::NUM_DIRS] = {  0,  1, 1, 1, 0, -1, -1, -1 };
+static const int DIR_DY[MoveDir::NUM_DIRS] = { -1, -1, 0, 1, 1,  1,  0, -1 };
+
+// Initialization constructor
+FringeSearch::FringeSearch(const GameMap &game_map, const PosTile &start_pos_arg, const PosTile &end_pos_arg,
+                           float robot_radius_arg, size_t max_bytes_arg)
+: game_map_ptr(&game_map), map_width(game_map.getWidth()), map_height(game_map.getHeight()),
+  start_pos(start_pos_arg), end_pos(end_pos_arg), robot_radius(robot_radius_arg),
+  status(SearchStatus::SEARCH_RUNNING), cache_bits(0), num_reached(0),
+  iteration_num(0), num_thresholds(1), max_fringe_size(0), max_bytes(max_bytes_arg), peak_bytes(0)
+{
+	MemScope mem_scope(MemSubsystem::MEM_SEARCH);
+
+	best_tile = start_pos.y*map_width + start_pos.x;
+	best_H = calcH(best_tile);
+	threshold = best_H;
+	next_threshold = INFINITY;
+
+	// The first cache, and the start tile on the "now" list
+	if(FRINGE_INIT_SLOTS*sizeof(CacheSlot) > max_bytes)
+	{
+		status = SearchStatus::SEARCH_MEMORY_LIMIT;
+		return;
+	}
+	CacheSlot empty_slot = { FRINGE_UNREACHED, FRINGE_UNREACHED };
+	cache_slots.assign(FRINGE_INIT_SLOTS, empty_slot);
+	while(((size_t)1 << cache_bits) < FRINGE_INIT_SLOTS)
+		++cache_bits;
+	peak_bytes = getBytes();
+
+	if(!setG(best_tile, 0, MoveDir::NUM_DIRS))
+		status = SearchStatus::SEARCH_MEMORY_LIMIT;
+}
+
+// Destructor
+FringeSearch::~FringeSearch()
+{
+	if(iteration_num > 0)
+		memRecordOpenList("FringeSearch", max_fringe_size, sizeof(FringeEntry));
+}
+
+// Visit up to max_visits fringe entries
+SearchStatus::Type FringeSearch::advance(unsigned long max_visits)
+{
+	MemScope mem_scope(MemSubsystem::MEM_SEARCH);
+
+	for(unsigned long visit_idx = 0; visit_idx < max_visits && status == SearchStatus::SEARCH_RUNNING; ++visit_idx)
+	{
+		if(!now_list.empty())
+		{
+			visit();
+			continue;
+		}
+
+		// This threshold is used up: the "later" entries go round again under the smallest F among them
+		if(later_list.empty())
+		{
+			status = SearchStatus::SEARCH_UNREACHABLE;
+			break;
+		}
+		threshold = next_threshold;
+		next_threshold = INFINITY;
+		now_list.swap(later_list);
+		reverse(now_list.begin(), now_list.end());	// Keep the fringe's order (the "now" list pops from the back)
+		++num_thresholds;
+	}
+
+	return status;
+}
+
+// Get the path (or the path to the best tile so far)
+void FringeSearch::getPath(vector<PosTile> &path) const
+{
+	path.clear();
+	if(num_reached == 0)
+		return;
+
+	// Follow the parent directions back to the start
+	uint32_t cur_tile = best_tile;
+	while(true)
+	{
+		PosTile tile = { cur_tile % map_width, cur_tile / map_width };
+		path.push_back(tile);
+		unsigned int dir = getGDir(cur_tile) & 0xF;
+		if(dir == MoveDir::NUM_DIRS)
+			break;
+		cur_tile = (tile.y - DIR_DY[dir])*map_width + (tile.x - DIR_DX[dir]);
+	}
+
+	reverse(path.begin(), path.end());
+}
+
+// Heuristic distance to the end point
+float FringeSearch::calcH(uint32_t tile) const
+{
+	// Always octile: Manhattan overestimates diagonal moves, and then tiles keep being
+	// expanded again with lower G (about 30x the expansions on set3.dat)
+	float dist_x = (float)abs((int)end_pos.x - (int)(tile % map_width));
+	float dist_y = (float)abs((int)end_pos.y - (int)(tile / map_width));
+	return max(dist_x, dist_y) + 0.4f*min(dist_x, dist_y);
+}
+
+// Find a tile's hash slot
+size_t FringeSearch::findSlot(uint32_t tile) const
+{
+	size_t slot_mask = cache_slots.size() - 1;
+	size_t slot_idx = (size_t)(((uint64_t)tile * 0x9E3779B97F4A7C15ULL) >> (64 - cache_bits));
+	while(cache_slots[slot_idx].tile != tile && cache_slots[slot_idx].tile != FRINGE_UNREACHED)
+		slot_idx = (slot_idx + 1) & slot_mask;
+	return slot_idx;
+}
+
+// Cache a tile's G, and queue it
+bool FringeSearch::setG(uint32_t tile, uint32_t G, unsigned int dir)
+{
+	if(now_list.size() == now_list.capacity() && !growList(now_list))
+		return false;
+
+	uint32_t G_dir = (G << 4) | dir;
+	if(!cache_plane.empty())
+	{
+		num_reached += (cache_plane[tile] == FRINGE_UNREACHED) ? 1 : 0;
+		cache_plane[tile] = G_dir;
+	}
+	else
+	{
+		size_t slot_idx = findSlot(tile);
+		if(cache_slots[slot_idx].tile == FRINGE_UNREACHED)
+		{
+			// Keep the hash at most 3/4 full
+			if((num_reached + 1)*4 > cache_slots.size()*3)
+			{
+				if(!growCache())
+					return false;
+				return setG(tile, G, dir);
+			}
+			cache_slots[slot_idx].tile = tile;
+			++num_reached;
+		}
+		cache_slots[slot_idx].G_dir = G_dir;
+	}
+
+	FringeEntry new_entry = { tile, G };
+	now_list.push_back(new_entry);
+	max_fringe_size = max(max_fringe_size, now_list.size() + later_list.size());
+	return true;
+}
+
+// Double the hashed G cache, or switch to the plane
+bool FringeSearch::growCache()
+{
+	// Both caches exist while the tiles are moved over, so switch while the hash is still
+	// small next to the plane (once it would pass half the plane's size)
+	size_t new_slots = cache_slots.size()*2;
+	size_t num_tiles = (size_t)map_width*map_height;
+	bool to_plane = (new_slots*sizeof(CacheSlot) > num_tiles*sizeof(uint32_t)/2);
+	size_t grow_bytes = getBytes() + (to_plane ? num_tiles*sizeof(uint32_t) : new_slots*sizeof(CacheSlot));
+	if(grow_bytes > max_bytes)
+		return false;
+	peak_bytes = max(peak_bytes, grow_bytes);
+
+	vector<CacheSlot> old_slots;
+	old_slots.swap(cache_slots);
+	if(to_plane)
+	{
+		cache_plane.assign(num_tiles, FRINGE_UNREACHED);
+		for(size_t slot_idx = 0; slot_idx < old_slots.size(); ++slot_idx)
+		{
+			if(old_slots[slot_idx].tile != FRINGE_UNREACHED)
+				cache_plane[old_slots[slot_idx].tile] = old_slots[slot_idx].G_dir;
+		}
+		return true;
+	}
+
+	CacheSlot empty_slot = { FRINGE_UNREACHED, FRINGE_UNREACHED };
+	cache_slots.assign(new_slots, empty_slot);
+	++cache_bits;
+	for(size_t slot_idx = 0; slot_idx < old_slots.size(); ++slot_idx)
+	{
+		if(old_slots[slot_idx].tile != FRINGE_UNREACHED)
+			cache_slots[findSlot(old_slots[slot_idx].tile)] = old_slots[slot_idx];
+	}
+	return true;
+}
+
+// Double a list
+bool FringeSearch::growList(vector<FringeEntry> &list)
+{
+	// Drop the stale entries first; that's often room enough
+	list.erase(remove_if(list.begin(), list.end(),
+	                     [this](const FringeEntry &entry) { return (getGDir(entry.tile) >> 4) != entry.G; }),
+	           list.end());
+	if(list.size() < list.capacity()/2)
+		return true;
+
+	// Both buffers exist while the entries are moved over
+	size_t new_capacity = max(list.capacity()*2, (size_t)64);
+	size_t grow_bytes = getBytes() + new_capacity*sizeof(FringeEntry);
+	if(grow_bytes > max_bytes)
+		return false;
+	peak_bytes = max(peak_bytes, grow_bytes);
+
+	list.reserve(new_capacity);
+	return true;
+}
+
+// Take the next "now" entry
+void FringeSearch::visit()
+{
+	FringeEntry cur_entry = now_list.back();
+	now_list.pop_back();
+
+	// Skip stale entries (the tile was queued again with a lower G)
+	uint32_t cur_G = getGDir(cur_entry.tile) >> 4;
+	if(cur_G != cur_entry.G)
+		return;
+
+	// Over the threshold: leave it for the next iteration
+	float cur_H = calcH(cur_entry.tile);
+	float cur_F = cur_G / FRINGE_COST_UNITS + cur_H;
+	if(cur_F > threshold)
+	{
+		if(later_list.size() == later_list.capacity() && !growList(later_list))
+		{
+			status = SearchStatus::SEARCH_MEMORY_LIMIT;
+			return;
+		}
+		later_list.push_back(cur_entry);
+		next_threshold = min(next_threshold, cur_F);
+		return;
+	}
+
+	// Done if it's the end point
+	uint32_t end_tile = end_pos.y*map_width + end_pos.x;
+	if(cur_entry.tile == end_tile)
+	{
+		best_tile = end_tile;
+		status = SearchStatus::SEARCH_FOUND;
+		return;
+	}
+
+	++iteration_num;
+	if(cur_H < best_H)
+	{
+		best_tile = cur_entry.tile;
+		best_H = cur_H;
+	}
+
+	// Queue every neighbour reached with a lower G than before (same moves and costs as AStar)
+	int cur_x = cur_entry.tile % map_width, cur_y = cur_entry.tile / map_width;
+	for(unsigned int dir = 0; dir < (unsigned int)MoveDir::NUM_DIRS; ++dir)
+	{
+		int new_x = cur_x + DIR_DX[dir], new_y = cur_y + DIR_DY[dir];
+		if(new_x < 0 || (unsigned int)new_x >= map_width ||
+		   new_y < 0 || (unsigned int)new_y >= map_height ||
+		   !game_map_ptr->isPassable(new_x, new_y, robot_radius))
+			continue;
+
+		uint32_t new_G = cur_G + ((DIR_DX[dir] != 0 && DIR_DY[dir] != 0) ? FRINGE_DIAGONAL_COST : FRINGE_STRAIGHT_COST);
+		uint32_t new_tile = new_y*map_width + new_x;
+		uint32_t old_G_dir = getGDir(new_tile);
+		if(old_G_dir != FRINGE_UNREACHED && (old_G_dir >> 4) <= new_G)
+			continue;
+
+		if(!setG(new_tile, new_G, dir))
+		{
+			status = SearchStatus::SEARCH_MEMORY_LIMIT;
+			return;
+		}
+	}
+
+	peak_bytes = max(peak_bytes, getBytes());
+}
@@ -6,57 +6,520 @@
  */
 
 #include "../headers/GameMap.hpp"
+#include "../headers/Parallel.hpp"
+#include "../headers/MapGenerator.hpp"
+#include "../headers/GridKernels.hpp"
+#include "../headers/MemProfile.hpp"
+
+#include <atomic>
+#include <mutex>
 
 using namespace std;
 
+// Pages alive in the process (see getNumLivePages())
+static atomic<long> num_live_pages(0);
+
+// Page bookkeeping
+MapPage::MapPage()
+: max_clearance(0.0f)
+{
+	++num_live_pages;
+}
+
+MapPage::~MapPage()
+{
+	--num_live_pages;
+}
+
 // Default constructor
 GameMap::GameMap()
+: map_width(0), map_height(0), row_words(0), version(nextVersion())
 {
 
 }
 
 // Initialization constructor
-GameMap::GameMap(const Json::Value &obstacles, unsigned int max_width, int max_height)
+GameMap::GameMap(const Json::Value &obstacles, unsigned int max_width, int max_height, PosTile *max_obs)
+: version(nextVersion())
 {
 	cout << "Constructing a GameMap (init)" << endl;
 
 	// Create the initial matrix
 	// Store the matrix in row-major order, so that debugging prints appear
 	//  in a human-readable fashion
-	the_map = vector< vector<bool> > (max_height,vector<bool>(max_width, true));
+	vector<uint64_t> words;
+	initOpen(max_width, max_height, words);
 
 #if DEBUG
 	// Make some obstacles (debugging)
-	createObstacles();
+	createObstacles(words);
 #else
-	// Initialize the obstacles
-	unsigned int obs_size = obstacles.size();
-	for(unsigned int obs_idx = 0; obs_idx < obs_size; ++obs_idx)
+	// Initialize the obstacles (set their tiles to 'false', not traversable)
+	PosTile obs_bounds;
+	rasteriseObstacles(obstacles, words, obs_bounds);
+	if(max_obs != NULL)
+		*max_obs = obs_bounds;
+#endif
+
+	// Find the distance from every tile to its nearest obstacle, and split the map into pages
+	setContents(words);
+
+}
+
+// Initialization constructor (packed obstacle bits)
+GameMap::GameMap(const vector<uint64_t> &obstacle_words, unsigned int width_arg, unsigned int height_arg)
+: version(nextVersion())
+{
+	initFromWords(obstacle_words, width_arg, height_arg);
+}
+
+// Destructor
+GameMap::~GameMap()
+{
+
+}
+
+// Load a map file
+bool GameMap::loadFile(const string &file_name, PosTile &robot_start, PosTile &robot_end)
+{
+	MemScope mem_scope(MemSubsystem::MEM_LOADER);
+
+	size_t extension_pos = file_name.rfind('.');
+	if(extension_pos != string::npos && file_name.substr(extension_pos + 1) == "bin")
+	{
+		// Binary maps carry their own size and start/end points
+		if(!loadBinary(file_name, robot_start, robot_end))
+		{
+			cout << "Failed to load binary map: " << file_name << endl;
+			return false;
+		}
+		cout << "Loaded binary map (" << getWidth() << "," << getHeight() << ")" << endl;
+		return true;
+	}
+
+	return loadJson(file_name, robot_start, robot_end);
+}
+
+// Load a JSON map file
+bool GameMap::loadJson(const string &file_name, PosTile &robot_start, PosTile &robot_end)
+{
+	// Try to load the .dat file
+	ifstream datFile;
+	string datString;
+	datFile.open(file_name.c_str());
+	if(datFile.is_open())
 	{
-		// Set the map location to 'false' (not traversable)
-		unsigned int obs_x = obstacles[obs_idx][(unsigned int)0].asUInt();
-		unsigned int obs_y = obstacles[obs_idx][(unsigned int)1].asUInt();
+		// All data provided as samples is formatted as a single line
+		// If other dat files contain multiple lines, the JSON parse below will not work
+		getline(datFile,datString);
+	}
+	else
+	{
+		cout << "Failed to open file: " << file_name << endl;
+		return false;
+	}
 
-		the_map[obs_y][obs_x] = false;
+
+	// Parse the .dat string
+	Json::Value root;
+	Json::Reader reader;
+	bool parsedSuccess = reader.parse(datString, root, false);
+	if(!parsedSuccess)
+	{
+		// Report failures and their locations in the document.
+		cout << "Failed to parse JSON" << endl
+			 <<	reader.getFormatedErrorMessages()
+			 << endl;
+		return false;
 	}
+
+	// Fetch the obstacles
+	// (by reference: a copy of the array would double the parse's memory for nothing)
+	const Json::Value &obstacles = root["obstacles"];
+
+	// Now that the data is loaded, build the map
+#if DEBUG
+	// Use a size of (20,20) for readability in debugging
+	*this = GameMap(obstacles, 20, 20);
+	printMap();
+#else
+	// Generated maps give their size; otherwise we'll use a default (1500,1500)
+	// because of supplied input data parameters
+	// The max_x and max_y within the obstacles come out of the same (parallel) pass that places them
+	unsigned int map_width  = root.get("width", 1500).asUInt();
+	unsigned int map_height = root.get("height", 1500).asUInt();
+	PosTile max_obs;
+	*this = GameMap(obstacles, map_width, map_height, &max_obs);
+	cout << "Max x/y = (" << max_obs.x << "," << max_obs.y << ")" << endl;
 #endif
 
+	// Load the start and end points
+#if DEBUG
+	robot_start.x = 1;	robot_start.y = 1;
+	robot_end.x = 19;	robot_end.y = 19;
+#else
+	const Json::Value &robot_start_dat = root["robotStart"];
+	const Json::Value &robot_end_dat   = root["robotEnd"];
+	robot_start.x = robot_start_dat[(unsigned int)0].asUInt();
+	robot_start.y = robot_start_dat[(unsigned int)1].asUInt();
+	robot_end.x = robot_end_dat[(unsigned int)0].asUInt();
+	robot_end.y = robot_end_dat[(unsigned int)1].asUInt();
+#endif
+
+	return true;
 }
 
-// Destructor
-GameMap::~GameMap()
+// Load a binary map file
+bool GameMap::loadBinary(const string &file_name, PosTile &robot_start, PosTile &robot_end)
+{
+	ifstream in_file(file_name.c_str(), ios::in | ios::binary);
+	if(!in_file.is_open())
+		return false;
+
+	// Header (all little-endian uint32): magic, version, width, height, start x/y, end x/y
+	unsigned char header_bytes[8*4];
+	if(!in_file.read((char *)header_bytes, sizeof(header_bytes)))
+		return false;
+	uint32_t header[8];
+	for(unsigned int field_idx = 0; field_idx < 8; ++field_idx)
+	{
+		header[field_idx] = 0;
+		for(unsigned int byte_idx = 0; byte_idx < 4; ++byte_idx)
+			header[field_idx] |= (uint32_t)header_bytes[field_idx*4 + byte_idx] << (8*byte_idx);
+	}
+	if(header[0] != MAP_BINARY_MAGIC || header[1] != MAP_BINARY_VERSION)
+	{
+		cout << "Not a binary map (or unsupported version): " << file_name << endl;
+		return false;
+	}
+	unsigned int map_width = header[2], map_height = header[3];
+	robot_start.x = header[4];
+	robot_start.y = header[5];
+	robot_end.x = header[6];
+	robot_end.y = header[7];
+	if(map_width == 0 || map_height == 0 || robot_start.x >= map_width || robot_start.y >= map_height ||
+	   robot_end.x >= map_width || robot_end.y >= map_height)
+	{
+		cout << "Bad binary map (empty, or start/end outside the map): " << file_name << endl;
+		return false;
+	}
+
+	// Obstacle rows (little-endian uint64 words)
+	size_t num_words = (size_t)((map_width + MAP_WORD_BITS - 1) / MAP_WORD_BITS) * map_height;
+	vector<unsigned char> word_bytes(num_words*8);
+	if(num_words > 0 && !in_file.read((char *)&word_bytes[0], word_bytes.size()))
+	{
+		cout << "Truncated binary map: " << file_name << endl;
+		return false;
+	}
+	vector<uint64_t> obstacle_words(num_words, 0);
+	for(size_t word_idx = 0; word_idx < num_words; ++word_idx)
+		for(unsigned int byte_idx = 0; byte_idx < 8; ++byte_idx)
+			obstacle_words[word_idx] |= (uint64_t)word_bytes[word_idx*8 + byte_idx] << (8*byte_idx);
+
+	initFromWords(obstacle_words, map_width, map_height);
+	version = nextVersion();
+	return true;
+}
+
+// Build the map from packed obstacle bits
+void GameMap::initFromWords(const vector<uint64_t> &obstacle_words, unsigned int width_arg, unsigned int height_arg)
 {
+	// Same row layout, so each traversable word is the inverted obstacle word
+	// (keeping the padding bits past the right edge clear)
+	vector<uint64_t> words;
+	initOpen(width_arg, height_arg, words);
+	size_t num_words = words.size();
+	for(size_t word_idx = 0; word_idx < num_words; ++word_idx)
+		words[word_idx] &= ~obstacle_words[word_idx];
+
+	setContents(words);
+}
+
+// Size the map, all traversable
+void GameMap::initOpen(unsigned int width_arg, unsigned int height_arg, vector<uint64_t> &words)
+{
+	MemScope mem_scope(MemSubsystem::MEM_MAP);
+
+	map_width = width_arg;
+	map_height = height_arg;
+	row_words = (map_width + MAP_WORD_BITS - 1) / MAP_WORD_BITS;
+	words.assign((size_t)row_words*map_height, ~(uint64_t)0);
+	pages.clear();
+	traversable_rows.clear();
+	clearance_rows.clear();
 
+	// Clear the padding bits of the last word of each row
+	unsigned int tail_bits = map_width % MAP_WORD_BITS;
+	if(tail_bits != 0)
+	{
+		for(unsigned int row_idx = 0; row_idx < map_height; ++row_idx)
+			words[(size_t)row_idx*row_words + row_words - 1] = ((uint64_t)1 << tail_bits) - 1;
+	}
+}
+
+// Place the obstacle primitives
+void GameMap::rasteriseObstacles(const Json::Value &obstacles, vector<uint64_t> &words, PosTile &max_obs) const
+{
+	max_obs.x = 0;
+	max_obs.y = 0;
+	mutex bounds_mutex;
+
+	// Each worker takes a block of the array (reading a parsed Json::Value is thread-safe)
+	parallelFor(obstacles.size(), [&](unsigned int obs_begin, unsigned int obs_end)
+	{
+		unsigned int block_max_x = 0, block_max_y = 0;
+		for(unsigned int obs_idx = obs_begin; obs_idx < obs_end; ++obs_idx)
+		{
+			// [x,y] tile, [x,y,length] run, or [x,y,width,height] rectangle
+			const Json::Value &obstacle = obstacles[obs_idx];
+			unsigned int obs_size = obstacle.size();
+			unsigned int obs_x = obstacle[(unsigned int)0].asUInt();
+			unsigned int obs_y = obstacle[(unsigned int)1].asUInt();
+			unsigned int obs_width  = (obs_size > 2) ? obstacle[(unsigned int)2].asUInt() : 1;
+			unsigned int obs_height = (obs_size > 3) ? obstacle[(unsigned int)3].asUInt() : 1;
+			if(obs_width == 0 || obs_height == 0)
+				continue;
+			block_max_x = max(block_max_x, obs_x + obs_width - 1);
+			block_max_y = max(block_max_y, obs_y + obs_height - 1);
+
+			// Clip to the map
+			if(obs_x >= map_width || obs_y >= map_height)
+				continue;
+			unsigned int col_end = min(obs_x + obs_width, map_width);
+			unsigned int row_end = min(obs_y + obs_height, map_height);
+
+			// Clear the columns' bits in each row, one word at a time
+			for(unsigned int row_idx = obs_y; row_idx < row_end; ++row_idx)
+			{
+				uint64_t *row = &words[(size_t)row_idx*row_words];
+				for(unsigned int col_idx = obs_x; col_idx < col_end; )
+				{
+					unsigned int bit_idx = col_idx % MAP_WORD_BITS;
+					unsigned int num_bits = min(col_end - col_idx, MAP_WORD_BITS - bit_idx);
+					uint64_t mask = ((num_bits == MAP_WORD_BITS) ? ~(uint64_t)0 : (((uint64_t)1 << num_bits) - 1)) << bit_idx;
+					__atomic_fetch_and(&row[col_idx / MAP_WORD_BITS], ~mask, __ATOMIC_RELAXED);
+					col_idx += num_bits;
+				}
+			}
+		}
+
+		lock_guard<mutex> bounds_lock(bounds_mutex);
+		max_obs.x = max(max_obs.x, block_max_x);
+		max_obs.y = max(max_obs.y, block_max_y);
+	});
+}
+
+// Compute the clearance, and page the map
+void GameMap::setContents(const vector<uint64_t> &words)
+{
+	MemScope mem_scope(MemSubsystem::MEM_MAP);
+
+	vector<const uint64_t *> rows(map_height);
+	for(unsigned int row_idx = 0; row_idx < map_height; ++row_idx)
+		rows[row_idx] = &words[(size_t)row_idx*row_words];
+	vector<float> clearance;
+	calcClearance(rows.data(), 0, 0, map_width, map_height, clearance);
+
+	// Keep every page whose words and clearance are unchanged, build new ones for the rest
+	unsigned int num_pages = (map_height + MAP_PAGE_ROWS - 1) / MAP_PAGE_ROWS;
+	pages.resize(num_pages);
+	for(unsigned int page_idx = 0; page_idx < num_pages; ++page_idx)
+	{
+		unsigned int row_begin = page_idx*MAP_PAGE_ROWS;
+		unsigned int page_rows = min((unsigned int)MAP_PAGE_ROWS, map_height - row_begin);
+		const uint64_t *page_words = &words[(size_t)row_begin*row_words];
+		const float *page_clearance = &clearance[(size_t)row_begin*map_width];
+		size_t num_words = (size_t)page_rows*row_words, num_values = (size_t)page_rows*map_width;
+
+		const MapPage *old_page = pages[page_idx].get();
+		if(old_page != NULL && old_page->words.size() == num_words && old_page->clearance.size() == num_values &&
+		   equal(page_words, page_words + num_words, old_page->words.begin()) &&
+		   equal(page_clearance, page_clearance + num_values, old_page->clearance.begin()))
+			continue;
+
+		shared_ptr<MapPage> new_page = make_shared<MapPage>();
+		new_page->words.assign(page_words, page_words + num_words);
+		new_page->clearance.assign(page_clearance, page_clearance + num_values);
+		new_page->max_clearance = *max_element(page_clearance, page_clearance + num_values);
+		pages[page_idx] = new_page;
+	}
+
+	// Point each row into its page
+	traversable_rows.resize(map_height);
+	clearance_rows.resize(map_height);
+	for(unsigned int page_idx = 0; page_idx < num_pages; ++page_idx)
+		pointRows(page_idx);
+}
+
+// Point a page's rows into it
+void GameMap::pointRows(unsigned int page_idx)
+{
+	const MapPage &page = *pages[page_idx];
+	unsigned int row_begin = page_idx*MAP_PAGE_ROWS;
+	unsigned int row_end = min(row_begin + MAP_PAGE_ROWS, map_height);
+	for(unsigned int row_idx = row_begin; row_idx < row_end; ++row_idx)
+	{
+		unsigned int page_row = row_idx - row_begin;
+		traversable_rows[row_idx] = &page.words[(size_t)page_row*row_words];
+		clearance_rows[row_idx] = &page.clearance[(size_t)page_row*map_width];
+	}
+}
+
+// Count the traversable tiles
+size_t GameMap::countTraversable() const
+{
+	size_t num_traversable = 0;
+	for(unsigned int page_idx = 0; page_idx < pages.size(); ++page_idx)
+		num_traversable += kernelCountBits(pages[page_idx]->words.data(), pages[page_idx]->words.size());
+	return num_traversable;
+}
+
+// Count pages in common with another map
+unsigned int GameMap::countSharedPages(const GameMap &other) const
+{
+	unsigned int num_shared = 0;
+	for(unsigned int page_idx = 0; page_idx < pages.size() && page_idx < other.pages.size(); ++page_idx)
+		num_shared += (pages[page_idx] == other.pages[page_idx]) ? 1 : 0;
+	return num_shared;
+}
+
+// Pages alive in the process
+long GameMap::getNumLivePages()
+{
+	return num_live_pages;
+}
+
+// Update a batch of obstacles
+void GameMap::updateObstacles(const vector<PosTile> &tiles, bool traversable)
+{
+	MemScope mem_scope(MemSubsystem::MEM_MAP);
+	version = nextVersion();
+
+	// Pages are copied (once) before they are edited; the others stay shared
+	unsigned int num_pages = pages.size();
+	vector< shared_ptr<MapPage> > new_pages(num_pages);
+	auto copyPage = [&](unsigned int page_idx) -> MapPage &
+	{
+		if(new_pages[page_idx] == NULL)
+		{
+			new_pages[page_idx] = make_shared<MapPage>();
+			new_pages[page_idx]->words = pages[page_idx]->words;
+			new_pages[page_idx]->clearance = pages[page_idx]->clearance;
+			new_pages[page_idx]->max_clearance = pages[page_idx]->max_clearance;
+		}
+		return *new_pages[page_idx];
+	};
+
+	// Edit the words of the tiles that change, and find the box around them
+	unsigned int box_x0 = map_width, box_y0 = map_height, box_x1 = 0, box_y1 = 0;
+	unsigned int num_tiles = tiles.size();
+	for(unsigned int tile_idx = 0; tile_idx < num_tiles; ++tile_idx)
+	{
+		unsigned int x = tiles[tile_idx].x, y = tiles[tile_idx].y;
+		if(getTraversable(x, y) == traversable)
+			continue;
+		MapPage &page = copyPage(y / MAP_PAGE_ROWS);
+		uint64_t &word = page.words[(size_t)(y % MAP_PAGE_ROWS)*row_words + x/MAP_WORD_BITS];
+		uint64_t bit = (uint64_t)1 << (x%MAP_WORD_BITS);
+		word = traversable ? (word | bit) : (word & ~bit);
+		box_x0 = min(box_x0, x);	box_x1 = max(box_x1, x);
+		box_y0 = min(box_y0, y);	box_y1 = max(box_y1, y);
+	}
+	if(box_x0 > box_x1)
+		return;		// No tile changed
+
+	// Read the new words from here on (the copies still hold the old clearance)
+	for(unsigned int page_idx = 0; page_idx < num_pages; ++page_idx)
+	{
+		if(new_pages[page_idx] == NULL)
+			continue;
+		pages[page_idx] = new_pages[page_idx];
+		pointRows(page_idx);
+	}
+
+	// A tile's clearance only changes if its old clearance reaches the box (its nearest obstacle
+	// was removed, or an added one is nearer), so each page's largest clearance bounds the band
+	// of rows and columns it can change in
+	unsigned int max_reach = max(map_width, map_height);
+	unsigned int band_y0 = box_y0, band_y1 = box_y1, reach = 0;
+	for(unsigned int page_idx = 0; page_idx < num_pages; ++page_idx)
+	{
+		unsigned int row_begin = page_idx*MAP_PAGE_ROWS;
+		unsigned int row_last = min(row_begin + MAP_PAGE_ROWS, map_height) - 1;
+		float max_clearance = pages[page_idx]->max_clearance;
+		unsigned int page_reach = (max_clearance >= (float)max_reach) ? max_reach : (unsigned int)ceil(max_clearance);
+		unsigned int rows_away = (row_last < box_y0) ? box_y0 - row_last : ((row_begin > box_y1) ? row_begin - box_y1 : 0);
+		if(rows_away > page_reach)
+			continue;
+		band_y0 = min(band_y0, max(row_begin, box_y0 - min(box_y0, page_reach)));
+		band_y1 = max(band_y1, min(row_last, box_y1 + page_reach));
+		reach = max(reach, page_reach);
+	}
+	unsigned int band_x0 = box_x0 - min(box_x0, reach);
+	unsigned int band_x1 = min(map_width - 1, box_x1 + reach);
+	unsigned int band_width = band_x1 - band_x0 + 1;
+
+	// Recompute the band's clearance in a window 'margin' wider on each side: a value up to
+	// 'margin' can only come from obstacles inside the window, so widen it until every tile
+	// in the band is within that (or the window is the whole map)
+	vector<float> window;
+	unsigned int margin = max(reach, 1u), win_x0, win_y0, win_width, win_height;
+	while(true)
+	{
+		win_x0 = band_x0 - min(band_x0, margin);
+		win_y0 = band_y0 - min(band_y0, margin);
+		win_width  = min(map_width - 1, band_x1 + margin) - win_x0 + 1;
+		win_height = min(map_height - 1, band_y1 + margin) - win_y0 + 1;
+		calcClearance(traversable_rows.data(), win_x0, win_y0, win_width, win_height, window);
+		if(win_width == map_width && win_height == map_height)
+			break;
+
+		bool exact = true;
+		for(unsigned int row_idx = band_y0; row_idx <= band_y1 && exact; ++row_idx)
+		{
+			const float *win_row = &window[(size_t)(row_idx - win_y0)*win_width + (band_x0 - win_x0)];
+			exact = (*max_element(win_row, win_row + band_width) <= (float)margin);
+		}
+		if(exact)
+			break;
+		margin = min(margin*2, max_reach);
+	}
+
+	// Copy the band's rows into their pages where they changed
+	for(unsigned int row_idx = band_y0; row_idx <= band_y1; ++row_idx)
+	{
+		const float *win_row = &window[(size_t)(row_idx - win_y0)*win_width + (band_x0 - win_x0)];
+		if(equal(win_row, win_row + band_width, clearance_rows[row_idx] + band_x0))
+			continue;
+		MapPage &page = copyPage(row_idx / MAP_PAGE_ROWS);
+		copy(win_row, win_row + band_width, &page.clearance[(size_t)(row_idx % MAP_PAGE_ROWS)*map_width + band_x0]);
+	}
+
+	for(unsigned int page_idx = 0; page_idx < num_pages; ++page_idx)
+	{
+		if(new_pages[page_idx] == NULL)
+			continue;
+		MapPage &page = *new_pages[page_idx];
+		page.max_clearance = *max_element(page.clearance.begin(), page.clearance.end());
+		pages[page_idx] = new_pages[page_idx];
+		pointRows(page_idx);
+	}
+}
+
+// Hand out a new map version
+unsigned long GameMap::nextVersion()
+{
+	static atomic<unsigned long> version_counter(0);
+	return ++version_counter;
 }
 
 // Create obstacles (for debugging)
-void GameMap::createObstacles()
+void GameMap::createObstacles(vector<uint64_t> &words)
 {
-	// Seed the random number generator
-	srand(time(NULL));
+	// Seed the random number generator (fixed, so debugging runs are repeatable)
+	srand(DEBUG_MAP_SEED);
 
-	unsigned int map_height = the_map.size();
-	unsigned int map_width  = the_map[0].size();
 	unsigned int num_obs = (map_height*map_width)/2;
 
 	for(unsigned int obs_idx = 0; obs_idx < num_obs; ++obs_idx)
@@ -67,25 +530,114 @@ void GameMap::createObstacles()
 		if((rand_x == 1 && rand_y == 1) || (rand_x == 19 && rand_y == 19))
 			continue;
 
-		the_map[rand_y][rand_x] = false;
+		setTraversable(words, rand_x, rand_y, false);
 
 	}
 }
 
+// Compute the clearance field (separable Euclidean distance transform)
+void GameMap::calcClearance(const uint64_t *const *rows, unsigned int win_x0, unsigned int win_y0,
+                            unsigned int win_width, unsigned int win_height, vector<float> &clearance) const
+{
+	clearance.assign((size_t)win_width*win_height, CLEARANCE_NONE);
+	if(win_width == 0)
+		return;
+
+	// Pass 1: distance (in rows) to the nearest obstacle in the same column
+	// Each thread owns a block of columns; the inner loops run across a row, so they vectorise
+	parallelFor(win_width, [&](unsigned int col_begin, unsigned int col_end)
+	{
+		// Obstacles are at distance 0, everything else starts "infinitely" far
+		for(unsigned int row_idx = 0; row_idx < win_height; ++row_idx)
+		{
+			const uint64_t *words = rows[win_y0 + row_idx];
+			float *row = &clearance[(size_t)row_idx*win_width];
+			for(unsigned int col_idx = col_begin; col_idx < col_end; ++col_idx)
+			{
+				unsigned int map_col = win_x0 + col_idx;
+				bool traversable = (words[map_col/MAP_WORD_BITS] >> (map_col%MAP_WORD_BITS)) & 1;
+				row[col_idx] = traversable ? CLEARANCE_NONE : 0.0f;
+			}
+		}
+
+		// Sweep down, then up
+		for(unsigned int row_idx = 1; row_idx < win_height; ++row_idx)
+		{
+			const float *prev = &clearance[(size_t)(row_idx - 1)*win_width];
+			float *row = &clearance[(size_t)row_idx*win_width];
+			for(unsigned int col_idx = col_begin; col_idx < col_end; ++col_idx)
+				row[col_idx] = min(row[col_idx], prev[col_idx] + 1.0f);
+		}
+		for(unsigned int row_idx = win_height - 1; row_idx-- > 0; )
+		{
+			const float *next = &clearance[(size_t)(row_idx + 1)*win_width];
+			float *row = &clearance[(size_t)row_idx*win_width];
+			for(unsigned int col_idx = col_begin; col_idx < col_end; ++col_idx)
+				row[col_idx] = min(row[col_idx], next[col_idx] + 1.0f);
+		}
+	});
+
+	// Pass 2: along each row, find the minimum of (col - q)^2 + column_dist(q)^2 over all q
+	// using the lower envelope of the parabolas rooted at each finite column distance
+	// Squares and intersections are kept in integers/doubles: float loses whole tiles once
+	// col^2 passes 2^24 (about 4096 columns), so only the final distance is rounded to float
+	parallelFor(win_height, [&](unsigned int row_begin, unsigned int row_end)
+	{
+		vector<int64_t> sq_dist(win_width);			// Squared column distance at each q
+		vector<unsigned int> roots(win_width);		// Columns of the parabolas in the envelope
+		vector<double> bounds(win_width + 1);		// Where each envelope parabola takes over
+
+		for(unsigned int row_idx = row_begin; row_idx < row_end; ++row_idx)
+		{
+			float *row = &clearance[(size_t)row_idx*win_width];
+
+			// Build the lower envelope (columns without an obstacle in them are skipped)
+			int num_roots = 0;
+			for(unsigned int q = 0; q < win_width; ++q)
+			{
+				if(row[q] >= CLEARANCE_NONE)
+					continue;
+				sq_dist[q] = (int64_t)row[q]*(int64_t)row[q];
+
+				double intersect = 0.0;
+				while(num_roots > 0)
+				{
+					unsigned int p = roots[num_roots - 1];
+					intersect = (double)((sq_dist[q] + (int64_t)q*q) - (sq_dist[p] + (int64_t)p*p)) / (2.0*((double)q - p));
+					if(intersect > bounds[num_roots - 1])
+						break;
+					--num_roots;
+				}
+				roots[num_roots] = q;
+				bounds[num_roots] = (num_roots == 0) ? -CLEARANCE_NONE : intersect;
+				++num_roots;
+			}
+			if(num_roots == 0)
+				continue;	// No obstacles in range of this row at all
+			bounds[num_roots] = CLEARANCE_NONE;
+
+			// Read the envelope back out
+			int env_idx = 0;
+			for(unsigned int col_idx = 0; col_idx < win_width; ++col_idx)
+			{
+				while(bounds[env_idx + 1] < (double)col_idx)
+					++env_idx;
+				int64_t col_dist = (int64_t)col_idx - roots[env_idx];
+				row[col_idx] = (float)sqrt((double)(col_dist*col_dist + sq_dist[roots[env_idx]]));
+			}
+		}
+	});
+}
+
 // Print map (for debugging)
 void GameMap::printMap()
 {
-	// Fetch the width/height
-	unsigned int map_width, map_height;
-	map_width =  the_map[0].size();
-	map_height = the_map.size();
-
 	// Cycle through the object printing the vectors
 	for(unsigned int row_idx = 0; row_idx < map_height; ++row_idx)
 	{
 		cout << "row: " << ((row_idx < 10)?" ":"") << row_idx << "\t";
 		for(unsigned int col_idx = 0; col_idx < map_width; ++col_idx)
-			cout << (the_map[row_idx][col_idx]?1:0);	// '1' = traversable, '0' = obstacle
+			cout << (getTraversable(col_idx, row_idx)?1:0);	// '1' = traversable, '0' = obstacle
 		cout << endl;
 	}
 }
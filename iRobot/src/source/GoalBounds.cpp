@@ -0,0 +1,313 @@
+/**
+ * GoalBounds.cpp
+ *  Created on: Oct 18, 2026
+ *      Author: iRobot maintainers
+ *     Purpose: Goal-bounding preprocessing for static maps (see GoalBounds.hpp)
+ */
+#include "../headers/GoalBounds.hpp"
+#include "../headers/AStar.hpp"
+#include "../headers/SubgoalGraph.hpp"
+#include "../headers/Parallel.hpp"
+#include "../headers/MemProfile.hpp"
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define GOAL_BOUNDS_MMAP 1
+#else
+#define GOAL_BOUNDS_MMAP 0
+#endif
+
+using namespace std;
+
+// Move costs in whole units for the sweeps (1 and 1.4, as in AStar, so ties are exact)
+#define SWEEP_STRAIGHT_COST	5
+#define SWEEP_DIAGONAL_COST	7
+
+// Buckets of the sweeps' circular bucket queue (must be more than the largest move cost)
+#define SWEEP_BUCKETS	8
+
+// Distance of a tile the sweep hasn't reached
+#define SWEEP_UNREACHED	0xFFFFFFFFu
+
+// Column/row step of each move, in MoveDir order
+static const int dir_dx[MoveDir::NUM_DIRS] = { 0, 1, 1, 1, 0, -1, -1, -1 };
+static const int dir_dy[MoveDir::NUM_DIRS] = { -1, -1, 0, 1, 1, 1, 0, -1 };
+
+/**
+ * Function: isLittleEndian()
+ *
+ * @param void
+ * @return bool 'true' if the host stores values little-endian (the side file's order)
+ */
+static bool isLittleEndian()
+{
+	uint16_t probe = 1;
+	return *(const unsigned char *)&probe == 1;
+}
+
+// Generic constructor
+GoalBounds::GoalBounds()
+: map_width(0), map_height(0), map_checksum(0), boxes(NULL), mapped_data(NULL), mapped_bytes(0)
+{
+
+}
+
+// Destructor
+GoalBounds::~GoalBounds()
+{
+	unmap();
+}
+
+// Build the bounds
+bool GoalBounds::build(const GameMap &game_map)
+{
+	MemScope mem_scope(MemSubsystem::MEM_MAP);
+
+	size_t num_tiles = (size_t)game_map.getWidth()*game_map.getHeight();
+	if(num_tiles > GOAL_BOUNDS_MAX_TILES || game_map.getWidth() > 0xFFFF || game_map.getHeight() > 0xFFFF)
+		return false;
+
+	vector<GoalBox>().swap(built_boxes);
+	unmap();
+	map_width = game_map.getWidth();
+	map_height = game_map.getHeight();
+	map_checksum = SubgoalGraph::calcChecksum(game_map);
+
+	// Free tiles, as bytes (the sweeps read them far more often than anything else), with a
+	// blocked border so the sweeps never check the map edges; tiles are indexed in this padded grid
+	unsigned int padded_width = map_width + 2;
+	size_t padded_tiles = (size_t)padded_width*(map_height + 2);
+	vector<uint8_t> free_tiles(padded_tiles, 0);
+	for(unsigned int row_idx = 0; row_idx < map_height; ++row_idx)
+		for(unsigned int col_idx = 0; col_idx < map_width; ++col_idx)
+			free_tiles[(size_t)(row_idx + 1)*padded_width + col_idx + 1] = game_map.isPassable(col_idx, row_idx, 0.0f) ? 1 : 0;
+
+	int dir_offsets[MoveDir::NUM_DIRS];
+	for(unsigned int dir = 0; dir < MoveDir::NUM_DIRS; ++dir)
+		dir_offsets[dir] = dir_dy[dir]*(int)padded_width + dir_dx[dir];
+
+	GoalBox empty_box = { 0xFFFF, 0xFFFF, 0, 0 };
+	built_boxes.assign(num_tiles*8, empty_box);
+
+	// One sweep per source tile; each block of sources has its own scratch space, and
+	// writes only its own sources' boxes
+	parallelFor(num_tiles, [&](unsigned int source_begin, unsigned int source_end)
+	{
+		MemScope block_scope(MemSubsystem::MEM_MAP);
+		vector<uint32_t> dist(padded_tiles, SWEEP_UNREACHED);
+		vector<uint8_t> first_moves(padded_tiles, 0);	// Moves from the source some shortest path starts with
+		vector<uint32_t> reached;
+		vector<uint32_t> buckets[SWEEP_BUCKETS];
+
+		for(uint32_t source_tile = source_begin; source_tile < source_end; ++source_tile)
+		{
+			uint32_t source = (source_tile / map_width + 1)*padded_width + source_tile % map_width + 1;
+
+			// Dijkstra with a circular bucket queue (costs are small integers)
+			dist[source] = 0;
+			reached.push_back(source);
+			buckets[0].push_back(source);
+			size_t num_queued = 1;
+			for(uint32_t cur_dist = 0; num_queued > 0; ++cur_dist)
+			{
+				vector<uint32_t> &bucket = buckets[cur_dist % SWEEP_BUCKETS];
+				for(size_t entry_idx = 0; entry_idx < bucket.size(); ++entry_idx)
+				{
+					--num_queued;
+					uint32_t tile = bucket[entry_idx];
+					if(dist[tile] != cur_dist)
+						continue;	// Stale (reached more cheaply since)
+
+					for(unsigned int dir = 0; dir < MoveDir::NUM_DIRS; ++dir)
+					{
+						uint32_t new_tile = tile + dir_offsets[dir];
+						if(!free_tiles[new_tile])
+							continue;
+
+						uint32_t new_dist = cur_dist + ((dir % 2 == 0) ? SWEEP_STRAIGHT_COST : SWEEP_DIAGONAL_COST);
+						uint8_t moves = (tile == source) ? (uint8_t)(1 << dir) : first_moves[tile];
+						if(new_dist < dist[new_tile])
+						{
+							if(dist[new_tile] == SWEEP_UNREACHED)
+								reached.push_back(new_tile);
+							dist[new_tile] = new_dist;
+							first_moves[new_tile] = moves;
+							buckets[new_dist % SWEEP_BUCKETS].push_back(new_tile);
+							++num_queued;
+						}
+						else if(new_dist == dist[new_tile])
+						{
+							// Another shortest path: its first move counts too (the tile isn't
+							// settled yet, since its distance is above cur_dist)
+							first_moves[new_tile] |= moves;
+						}
+					}
+				}
+				bucket.clear();
+			}
+
+			// Grow each move's box by the tiles its shortest paths reach, and reset the scratch space
+			GoalBox *source_boxes = &built_boxes[(size_t)source_tile*8];
+			for(size_t reached_idx = 0; reached_idx < reached.size(); ++reached_idx)
+			{
+				uint32_t tile = reached[reached_idx];
+				uint16_t tile_x = tile % padded_width - 1, tile_y = tile / padded_width - 1;
+				for(uint8_t moves = first_moves[tile]; moves != 0; moves &= moves - 1)
+				{
+					GoalBox &box = source_boxes[__builtin_ctz(moves)];
+					box.min_x = min(box.min_x, tile_x);
+					box.min_y = min(box.min_y, tile_y);
+					box.max_x = max(box.max_x, tile_x);
+					box.max_y = max(box.max_y, tile_y);
+				}
+				dist[tile] = SWEEP_UNREACHED;
+				first_moves[tile] = 0;
+			}
+			reached.clear();
+		}
+	});
+
+	boxes = built_boxes.data();
+	return true;
+}
+
+// Write the side file
+bool GoalBounds::save(const string &file_name) const
+{
+	if(boxes == NULL)
+		return false;
+
+	ofstream out_file(file_name.c_str(), ios::out | ios::binary);
+	if(!out_file.is_open())
+		return false;
+
+	// Header (all little-endian uint32): magic, version, width, height, checksum low/high
+	uint32_t header[GOAL_BOUNDS_HEADER_WORDS] = { GOAL_BOUNDS_MAGIC, GOAL_BOUNDS_VERSION, map_width, map_height,
+	                                              (uint32_t)(map_checksum & 0xFFFFFFFFu), (uint32_t)(map_checksum >> 32) };
+	unsigned char header_bytes[GOAL_BOUNDS_HEADER_WORDS*4];
+	for(unsigned int word_idx = 0; word_idx < GOAL_BOUNDS_HEADER_WORDS; ++word_idx)
+		for(unsigned int byte_idx = 0; byte_idx < 4; ++byte_idx)
+			header_bytes[word_idx*4 + byte_idx] = (unsigned char)((header[word_idx] >> (8*byte_idx)) & 0xFF);
+	out_file.write((const char *)header_bytes, sizeof(header_bytes));
+
+	// Boxes (little-endian uint16 min x/y, max x/y), swapped a row of tiles at a time if the host isn't
+	size_t row_values = (size_t)map_width*8*4;
+	vector<uint16_t> row_buffer(row_values);
+	for(unsigned int row_idx = 0; row_idx < map_height; ++row_idx)
+	{
+		memcpy(&row_buffer[0], &boxes[(size_t)row_idx*map_width*8], row_values*sizeof(uint16_t));
+		if(!isLittleEndian())
+		{
+			for(size_t value_idx = 0; value_idx < row_values; ++value_idx)
+				row_buffer[value_idx] = (uint16_t)((row_buffer[value_idx] >> 8) | (row_buffer[value_idx] << 8));
+		}
+		out_file.write((const char *)&row_buffer[0], row_values*sizeof(uint16_t));
+	}
+
+	return out_file.good();
+}
+
+// Map the side file
+bool GoalBounds::load(const string &file_name, const GameMap &game_map)
+{
+	// The boxes are read in place, so they must already be in the host's order
+	if(!isLittleEndian())
+		return false;
+
+	ifstream in_file(file_name.c_str(), ios::in | ios::binary);
+	if(!in_file.is_open())
+		return false;
+
+	unsigned char header_bytes[GOAL_BOUNDS_HEADER_WORDS*4];
+	uint32_t header[GOAL_BOUNDS_HEADER_WORDS] = { 0 };
+	if(in_file.read((char *)header_bytes, sizeof(header_bytes)))
+	{
+		for(unsigned int word_idx = 0; word_idx < GOAL_BOUNDS_HEADER_WORDS; ++word_idx)
+			for(unsigned int byte_idx = 0; byte_idx < 4; ++byte_idx)
+				header[word_idx] |= (uint32_t)header_bytes[word_idx*4 + byte_idx] << (8*byte_idx);
+	}
+	if(header[0] != GOAL_BOUNDS_MAGIC || header[1] != GOAL_BOUNDS_VERSION)
+	{
+		cout << "Not a goal bounds file (or unsupported version): " << file_name << endl;
+		return false;
+	}
+	uint64_t file_checksum = (uint64_t)header[4] | ((uint64_t)header[5] << 32);
+	if(header[2] != game_map.getWidth() || header[3] != game_map.getHeight() ||
+	   file_checksum != SubgoalGraph::calcChecksum(game_map))
+	{
+		cout << "Goal bounds were built for a different map: " << file_name << endl;
+		return false;
+	}
+
+	size_t box_bytes = (size_t)header[2]*header[3]*8*sizeof(GoalBox);
+	size_t file_bytes = sizeof(header_bytes) + box_bytes;
+	in_file.seekg(0, ios::end);
+	if((size_t)in_file.tellg() < file_bytes)
+	{
+		cout << "Truncated goal bounds: " << file_name << endl;
+		return false;
+	}
+
+	// (any bounds held now are only replaced once the new ones are in)
+#if GOAL_BOUNDS_MMAP
+	// Map the whole file read-only; pages are read in as the search touches them
+	in_file.close();
+	int file_desc = open(file_name.c_str(), O_RDONLY);
+	if(file_desc < 0)
+		return false;
+	void *data = mmap(NULL, file_bytes, PROT_READ, MAP_SHARED, file_desc, 0);
+	close(file_desc);
+	if(data == MAP_FAILED)
+		return false;
+	vector<GoalBox>().swap(built_boxes);
+	unmap();
+	mapped_data = data;
+	mapped_bytes = file_bytes;
+	boxes = (const GoalBox *)((const char *)data + sizeof(header_bytes));
+#else
+	// No mmap() here: read the boxes into memory instead
+	vector<GoalBox> new_boxes(box_bytes / sizeof(GoalBox));
+	in_file.seekg(sizeof(header_bytes), ios::beg);
+	if(!in_file.read((char *)new_boxes.data(), box_bytes))
+		return false;
+	built_boxes.swap(new_boxes);
+	unmap();
+#endif
+
+	map_width = header[2];
+	map_height = header[3];
+	map_checksum = file_checksum;
+	return true;
+}
+
+// Load the side file, or build and save it
+bool GoalBounds::loadOrBuild(const string &file_name, const GameMap &game_map)
+{
+	if(load(file_name, game_map))
+		return true;
+
+	if(!build(game_map))
+	{
+		cout << "Map too large for goal bounds (over " << GOAL_BOUNDS_MAX_TILES << " tiles)" << endl;
+		return false;
+	}
+	// Use the file's mapping from now on (the built bounds stay if it can't be written or mapped)
+	if(!save(file_name) || !load(file_name, game_map))
+		cout << "Failed to write goal bounds, using them from memory: " << file_name << endl;
+	return true;
+}
+
+// Release the mapping
+void GoalBounds::unmap()
+{
+#if GOAL_BOUNDS_MMAP
+	if(mapped_data != NULL)
+		munmap(mapped_data, mapped_bytes);
+#endif
+	mapped_data = NULL;
+	mapped_bytes = 0;
+	boxes = built_boxes.empty() ? NULL : built_boxes.data();
+}
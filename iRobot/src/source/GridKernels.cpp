@@ -0,0 +1,380 @@
+/**
+ * GridKernels.cpp
+ *  Created on: Oct 18, 2026
+ *      Author: iRobot maintainers
+ *     Purpose: Vectorised kernels for full-grid passes, with runtime dispatch
+ *              The SSE/AVX2 versions are compiled with per-function target attributes, so the
+ *              rest of the program keeps the default (baseline x86-64) instruction set
+ */
+#include "../headers/GridKernels.hpp"
+
+#if defined(__GNUC__) && defined(__x86_64__)
+#define GRID_KERNELS_X86 1
+#include <immintrin.h>
+#else
+#define GRID_KERNELS_X86 0
+#endif
+
+using namespace std;
+
+// One version of every kernel (findWord() returns the first non-zero word in
+// [begin_word, end_word), or end_word)
+struct KernelTable
+{
+	void (*fill)(float *values, size_t num_values, float value);
+	void (*manhattanRow)(float *values, unsigned int map_width, unsigned int goal_x, unsigned int row_dist);
+	void (*octileRow)(float *values, unsigned int map_width, unsigned int goal_x, unsigned int row_dist);
+	size_t (*countBits)(const uint64_t *words, size_t num_words);
+	size_t (*findWord)(const uint64_t *words, size_t begin_word, size_t end_word);
+};
+
+//---------------------------------------------------------------------
+// Scalar versions
+//---------------------------------------------------------------------
+static void fillScalar(float *values, size_t num_values, float value)
+{
+	for(size_t value_idx = 0; value_idx < num_values; ++value_idx)
+		values[value_idx] = value;
+}
+
+static void manhattanRowScalar(float *values, unsigned int map_width, unsigned int goal_x, unsigned int row_dist)
+{
+	for(unsigned int col_idx = 0; col_idx < map_width; ++col_idx)
+		values[col_idx] = (float)(abs((int)goal_x - (int)col_idx) + (int)row_dist);
+}
+
+static void octileRowScalar(float *values, unsigned int map_width, unsigned int goal_x, unsigned int row_dist)
+{
+	float dist_y = (float)row_dist;
+	for(unsigned int col_idx = 0; col_idx < map_width; ++col_idx)
+	{
+		float dist_x = (float)abs((int)goal_x - (int)col_idx);
+		values[col_idx] = max(dist_x, dist_y) + 0.4f*min(dist_x, dist_y);
+	}
+}
+
+static size_t countBitsScalar(const uint64_t *words, size_t num_words)
+{
+	size_t num_bits = 0;
+	for(size_t word_idx = 0; word_idx < num_words; ++word_idx)
+		num_bits += __builtin_popcountll(words[word_idx]);
+	return num_bits;
+}
+
+static size_t findWordScalar(const uint64_t *words, size_t begin_word, size_t end_word)
+{
+	while(begin_word < end_word && words[begin_word] == 0)
+		++begin_word;
+	return begin_word;
+}
+
+#if GRID_KERNELS_X86
+//---------------------------------------------------------------------
+// SSE4.2 versions
+//---------------------------------------------------------------------
+__attribute__((target("sse4.2")))
+static void fillSse(float *values, size_t num_values, float value)
+{
+	__m128 fill_value = _mm_set1_ps(value);
+	size_t value_idx = 0;
+	if(num_values*sizeof(float) > KERNEL_STREAM_BYTES)
+	{
+		// Streaming stores need 16-byte alignment
+		for( ; value_idx < num_values && ((uintptr_t)&values[value_idx] & 15) != 0; ++value_idx)
+			values[value_idx] = value;
+		for( ; value_idx + 4 <= num_values; value_idx += 4)
+			_mm_stream_ps(&values[value_idx], fill_value);
+		_mm_sfence();
+	}
+	for( ; value_idx + 4 <= num_values; value_idx += 4)
+		_mm_storeu_ps(&values[value_idx], fill_value);
+	for( ; value_idx < num_values; ++value_idx)
+		values[value_idx] = value;
+}
+
+__attribute__((target("sse4.2")))
+static void manhattanRowSse(float *values, unsigned int map_width, unsigned int goal_x, unsigned int row_dist)
+{
+	__m128i cols = _mm_setr_epi32(0, 1, 2, 3);
+	__m128i goal = _mm_set1_epi32((int)goal_x);
+	__m128i dist_y = _mm_set1_epi32((int)row_dist);
+	__m128i step = _mm_set1_epi32(4);
+	unsigned int col_idx = 0;
+	for( ; col_idx + 4 <= map_width; col_idx += 4)
+	{
+		__m128i dist = _mm_add_epi32(_mm_abs_epi32(_mm_sub_epi32(goal, cols)), dist_y);
+		_mm_storeu_ps(&values[col_idx], _mm_cvtepi32_ps(dist));
+		cols = _mm_add_epi32(cols, step);
+	}
+	manhattanRowScalar(&values[col_idx], map_width - col_idx, goal_x - col_idx, row_dist);
+}
+
+__attribute__((target("sse4.2")))
+static void octileRowSse(float *values, unsigned int map_width, unsigned int goal_x, unsigned int row_dist)
+{
+	__m128i cols = _mm_setr_epi32(0, 1, 2, 3);
+	__m128i goal = _mm_set1_epi32((int)goal_x);
+	__m128 dist_y = _mm_set1_ps((float)row_dist);
+	__m128 diag_extra = _mm_set1_ps(0.4f);
+	__m128i step = _mm_set1_epi32(4);
+	unsigned int col_idx = 0;
+	for( ; col_idx + 4 <= map_width; col_idx += 4)
+	{
+		__m128 dist_x = _mm_cvtepi32_ps(_mm_abs_epi32(_mm_sub_epi32(goal, cols)));
+		__m128 longer = _mm_max_ps(dist_x, dist_y), shorter = _mm_min_ps(dist_x, dist_y);
+		_mm_storeu_ps(&values[col_idx], _mm_add_ps(longer, _mm_mul_ps(diag_extra, shorter)));
+		cols = _mm_add_epi32(cols, step);
+	}
+	octileRowScalar(&values[col_idx], map_width - col_idx, goal_x - col_idx, row_dist);
+}
+
+__attribute__((target("sse4.2,popcnt")))
+static size_t countBitsSse(const uint64_t *words, size_t num_words)
+{
+	// Four independent sums, so the popcnts don't wait on each other
+	uint64_t sums[4] = { 0, 0, 0, 0 };
+	size_t word_idx = 0;
+	for( ; word_idx + 4 <= num_words; word_idx += 4)
+	{
+		sums[0] += _mm_popcnt_u64(words[word_idx]);
+		sums[1] += _mm_popcnt_u64(words[word_idx + 1]);
+		sums[2] += _mm_popcnt_u64(words[word_idx + 2]);
+		sums[3] += _mm_popcnt_u64(words[word_idx + 3]);
+	}
+	for( ; word_idx < num_words; ++word_idx)
+		sums[0] += _mm_popcnt_u64(words[word_idx]);
+	return sums[0] + sums[1] + sums[2] + sums[3];
+}
+
+__attribute__((target("sse4.2")))
+static size_t findWordSse(const uint64_t *words, size_t begin_word, size_t end_word)
+{
+	// Four words per test (two vectors OR-ed together), then find the word in the block
+	for( ; begin_word + 4 <= end_word; begin_word += 4)
+	{
+		__m128i block = _mm_or_si128(_mm_loadu_si128((const __m128i *)&words[begin_word]),
+		                             _mm_loadu_si128((const __m128i *)&words[begin_word + 2]));
+		if(!_mm_testz_si128(block, block))
+			break;
+	}
+	return findWordScalar(words, begin_word, end_word);
+}
+
+//---------------------------------------------------------------------
+// AVX2 versions
+//---------------------------------------------------------------------
+__attribute__((target("avx2")))
+static void fillAvx2(float *values, size_t num_values, float value)
+{
+	__m256 fill_value = _mm256_set1_ps(value);
+	size_t value_idx = 0;
+	if(num_values*sizeof(float) > KERNEL_STREAM_BYTES)
+	{
+		// Streaming stores need 32-byte alignment
+		for( ; value_idx < num_values && ((uintptr_t)&values[value_idx] & 31) != 0; ++value_idx)
+			values[value_idx] = value;
+		for( ; value_idx + 8 <= num_values; value_idx += 8)
+			_mm256_stream_ps(&values[value_idx], fill_value);
+		_mm_sfence();
+	}
+	for( ; value_idx + 8 <= num_values; value_idx += 8)
+		_mm256_storeu_ps(&values[value_idx], fill_value);
+	for( ; value_idx < num_values; ++value_idx)
+		values[value_idx] = value;
+}
+
+__attribute__((target("avx2")))
+static void manhattanRowAvx2(float *values, unsigned int map_width, unsigned int goal_x, unsigned int row_dist)
+{
+	__m256i cols = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+	__m256i goal = _mm256_set1_epi32((int)goal_x);
+	__m256i dist_y = _mm256_set1_epi32((int)row_dist);
+	__m256i step = _mm256_set1_epi32(8);
+	unsigned int col_idx = 0;
+	for( ; col_idx + 8 <= map_width; col_idx += 8)
+	{
+		__m256i dist = _mm256_add_epi32(_mm256_abs_epi32(_mm256_sub_epi32(goal, cols)), dist_y);
+		_mm256_storeu_ps(&values[col_idx], _mm256_cvtepi32_ps(dist));
+		cols = _mm256_add_epi32(cols, step);
+	}
+	manhattanRowScalar(&values[col_idx], map_width - col_idx, goal_x - col_idx, row_dist);
+}
+
+__attribute__((target("avx2")))
+static void octileRowAvx2(float *values, unsigned int map_width, unsigned int goal_x, unsigned int row_dist)
+{
+	__m256i cols = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+	__m256i goal = _mm256_set1_epi32((int)goal_x);
+	__m256 dist_y = _mm256_set1_ps((float)row_dist);
+	__m256 diag_extra = _mm256_set1_ps(0.4f);
+	__m256i step = _mm256_set1_epi32(8);
+	unsigned int col_idx = 0;
+	for( ; col_idx + 8 <= map_width; col_idx += 8)
+	{
+		// Separate multiply and add (no FMA), so the results match the scalar version exactly
+		__m256 dist_x = _mm256_cvtepi32_ps(_mm256_abs_epi32(_mm256_sub_epi32(goal, cols)));
+		__m256 longer = _mm256_max_ps(dist_x, dist_y), shorter = _mm256_min_ps(dist_x, dist_y);
+		_mm256_storeu_ps(&values[col_idx], _mm256_add_ps(longer, _mm256_mul_ps(diag_extra, shorter)));
+		cols = _mm256_add_epi32(cols, step);
+	}
+	octileRowScalar(&values[col_idx], map_width - col_idx, goal_x - col_idx, row_dist);
+}
+
+__attribute__((target("avx2,popcnt")))
+static size_t countBitsAvx2(const uint64_t *words, size_t num_words)
+{
+	// Nibble lookup popcount: count each byte with two table shuffles, then sum
+	// the bytes of each 64-bit lane with SAD against zero
+	const __m256i nibble_counts = _mm256_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+	                                               0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+	const __m256i low_mask = _mm256_set1_epi8(0x0F);
+	__m256i sums = _mm256_setzero_si256();
+	size_t word_idx = 0;
+	for( ; word_idx + 4 <= num_words; word_idx += 4)
+	{
+		__m256i block = _mm256_loadu_si256((const __m256i *)&words[word_idx]);
+		__m256i low = _mm256_and_si256(block, low_mask);
+		__m256i high = _mm256_and_si256(_mm256_srli_epi16(block, 4), low_mask);
+		__m256i byte_counts = _mm256_add_epi8(_mm256_shuffle_epi8(nibble_counts, low),
+		                                      _mm256_shuffle_epi8(nibble_counts, high));
+		sums = _mm256_add_epi64(sums, _mm256_sad_epu8(byte_counts, _mm256_setzero_si256()));
+	}
+
+	uint64_t lane_sums[4];
+	_mm256_storeu_si256((__m256i *)lane_sums, sums);
+	size_t num_bits = lane_sums[0] + lane_sums[1] + lane_sums[2] + lane_sums[3];
+	for( ; word_idx < num_words; ++word_idx)
+		num_bits += _mm_popcnt_u64(words[word_idx]);
+	return num_bits;
+}
+
+__attribute__((target("avx2")))
+static size_t findWordAvx2(const uint64_t *words, size_t begin_word, size_t end_word)
+{
+	// Eight words per test (two vectors OR-ed together), then find the word in the block
+	for( ; begin_word + 8 <= end_word; begin_word += 8)
+	{
+		__m256i block = _mm256_or_si256(_mm256_loadu_si256((const __m256i *)&words[begin_word]),
+		                                _mm256_loadu_si256((const __m256i *)&words[begin_word + 4]));
+		if(!_mm256_testz_si256(block, block))
+			break;
+	}
+	return findWordScalar(words, begin_word, end_word);
+}
+#endif
+
+//---------------------------------------------------------------------
+// Dispatch
+//---------------------------------------------------------------------
+#if GRID_KERNELS_X86
+static const KernelTable kernel_tables[KernelLevel::NUM_LEVELS] = {
+	{ fillScalar, manhattanRowScalar, octileRowScalar, countBitsScalar, findWordScalar },
+	{ fillSse,    manhattanRowSse,    octileRowSse,    countBitsSse,    findWordSse },
+	{ fillAvx2,   manhattanRowAvx2,   octileRowAvx2,   countBitsAvx2,   findWordAvx2 }
+};
+#else
+static const KernelTable kernel_tables[KernelLevel::NUM_LEVELS] = {
+	{ fillScalar, manhattanRowScalar, octileRowScalar, countBitsScalar, findWordScalar },
+	{ fillScalar, manhattanRowScalar, octileRowScalar, countBitsScalar, findWordScalar },
+	{ fillScalar, manhattanRowScalar, octileRowScalar, countBitsScalar, findWordScalar }
+};
+#endif
+
+/**
+ * Function: activeTable()
+ * Use: The kernels in use (the best supported level, picked on first use)
+ *
+ * @param void
+ * @return const KernelTable*& The active table
+ */
+static const KernelTable *&activeTable()
+{
+	static const KernelTable *active_table = &kernel_tables[getBestKernelLevel()];
+	return active_table;
+}
+
+// Best level this CPU supports
+KernelLevel::Type getBestKernelLevel()
+{
+#if GRID_KERNELS_X86
+	__builtin_cpu_init();
+	if(__builtin_cpu_supports("popcnt"))
+	{
+		if(__builtin_cpu_supports("avx2"))
+			return KernelLevel::KERNEL_AVX2;
+		if(__builtin_cpu_supports("sse4.2"))
+			return KernelLevel::KERNEL_SSE;
+	}
+#endif
+	return KernelLevel::KERNEL_SCALAR;
+}
+
+// Level in use
+KernelLevel::Type getKernelLevel()
+{
+	return (KernelLevel::Type)(activeTable() - kernel_tables);
+}
+
+// Switch levels
+bool setKernelLevel(KernelLevel::Type level)
+{
+	if(level >= KernelLevel::NUM_LEVELS || level > getBestKernelLevel())
+		return false;
+	activeTable() = &kernel_tables[level];
+	return true;
+}
+
+// Level names
+const char *getKernelLevelName(KernelLevel::Type level)
+{
+	switch(level)
+	{
+	case KernelLevel::KERNEL_SCALAR:	return "scalar";
+	case KernelLevel::KERNEL_SSE:		return "sse4.2";
+	case KernelLevel::KERNEL_AVX2:		return "avx2";
+	default:							return "unknown";
+	}
+}
+
+// Kernels (through the active table)
+void kernelFill(float *values, size_t num_values, float value)
+{
+	activeTable()->fill(values, num_values, value);
+}
+
+void kernelManhattanRow(float *values, unsigned int map_width, unsigned int goal_x, unsigned int row_dist)
+{
+	activeTable()->manhattanRow(values, map_width, goal_x, row_dist);
+}
+
+void kernelOctileRow(float *values, unsigned int map_width, unsigned int goal_x, unsigned int row_dist)
+{
+	activeTable()->octileRow(values, map_width, goal_x, row_dist);
+}
+
+size_t kernelCountBits(const uint64_t *words, size_t num_words)
+{
+	return activeTable()->countBits(words, num_words);
+}
+
+size_t kernelFindBit(const uint64_t *words, size_t begin_bit, size_t end_bit)
+{
+	if(begin_bit >= end_bit)
+		return end_bit;
+
+	// Partial first word (bits below begin_bit masked off)
+	size_t word_idx = begin_bit / 64;
+	uint64_t word = words[word_idx] & (~(uint64_t)0 << (begin_bit % 64));
+	if(word == 0)
+	{
+		// Whole words, up to and including the one holding the last bit
+		size_t end_word = (end_bit + 63) / 64;
+		word_idx = activeTable()->findWord(words, word_idx + 1, end_word);
+		if(word_idx == end_word)
+			return end_bit;
+		word = words[word_idx];
+	}
+
+	size_t found_bit = word_idx*64 + __builtin_ctzll(word);
+	return min(found_bit, end_bit);
+}
@@ -0,0 +1,400 @@
+/**
+ * MapGenerator.cpp
+ *  Created on: Oct 18, 2026
+ *      Author: iRobot maintainers
+ *     Purpose: Deterministic (seeded) synthetic map generator for stress and scaling runs
+ */
+#include "../headers/MapGenerator.hpp"
+
+#include <charconv>
+
+using namespace std;
+
+// Maze cells are MAZE_CELL_SIZE tiles apart (corridor width = MAZE_CELL_SIZE - 1)
+#define MAZE_CELL_SIZE		4
+
+// Room sizes (tiles), and map area per room placement attempt
+#define ROOM_MIN_SIZE		6
+#define ROOM_MAX_SIZE		24
+#define ROOM_AREA_PER_TRY	1000
+#define CORRIDOR_WIDTH		2
+
+// Warehouse layout (tiles): racks are RACK_WIDTH x RACK_LENGTH, separated by aisles
+#define RACK_WIDTH			2
+#define RACK_LENGTH			20
+#define AISLE_WIDTH			3
+#define CROSS_AISLE_WIDTH	4
+#define DOCK_DEPTH			10	// Open staging area along the top wall
+#define RACK_GAP_PERCENT	5	// Chance of a missing rack
+
+// Output is flushed to disk in blocks of this size
+#define WRITE_BLOCK_BYTES	(1 << 20)
+
+// Attempts at finding a free tile before giving up on a query
+#define QUERY_MAX_TRIES		100000
+
+// Initialization constructor
+MapGenerator::MapGenerator(unsigned int width_arg, unsigned int height_arg, unsigned long long seed_arg)
+: width(width_arg), height(height_arg), row_words((width_arg + MAP_WORD_BITS - 1) / MAP_WORD_BITS),
+  obstacle_words((size_t)row_words*height_arg, 0), rng_state(seed_arg)
+{
+
+}
+
+// Destructor
+MapGenerator::~MapGenerator()
+{
+
+}
+
+// Build the obstacles for a topology
+void MapGenerator::generate(MapTopology::Type topology, double density)
+{
+	fill(obstacle_words.begin(), obstacle_words.end(), 0);
+
+	switch(topology)
+	{
+	case MapTopology::TOPO_RANDOM:		generateRandom(density);	break;
+	case MapTopology::TOPO_MAZE:		generateMaze();				break;
+	case MapTopology::TOPO_ROOMS:		generateRooms();			break;
+	case MapTopology::TOPO_WAREHOUSE:	generateWarehouse();		break;
+	default:															break;
+	}
+}
+
+// Pick random start/end pairs on traversable tiles
+void MapGenerator::generateQueries(unsigned int num_queries, vector<PathQueryPair> &queries)
+{
+	queries.clear();
+	if(width == 0 || height == 0)
+		return;
+
+	for(unsigned int query_idx = 0; query_idx < num_queries; ++query_idx)
+	{
+		PosTile ends[2];
+		for(unsigned int end_idx = 0; end_idx < 2; ++end_idx)
+		{
+			unsigned int tries = 0;
+			do
+			{
+				ends[end_idx].x = randomBelow(width);
+				ends[end_idx].y = randomBelow(height);
+			} while(getBlocked(ends[end_idx].x, ends[end_idx].y) && ++tries < QUERY_MAX_TRIES);
+
+			if(tries == QUERY_MAX_TRIES)
+				return;	// (Almost) no traversable tiles
+		}
+
+		PathQueryPair query = { ends[0], ends[1] };
+		queries.push_back(query);
+	}
+}
+
+// Write the map in the JSON format
+bool MapGenerator::writeJson(const string &file_name, const PathQueryPair &query, bool use_runs) const
+{
+	ofstream out_file(file_name.c_str(), ios::out | ios::binary);
+	if(!out_file.is_open())
+		return false;
+
+	// Format into a block buffer with to_chars, flushing it whenever it's nearly full
+	vector<char> block(WRITE_BLOCK_BYTES + 64);
+	char *out = &block[0];
+	char *block_end = &block[0] + block.size();
+	bool first = true;
+
+	const char *head = "{\"obstacles\": [";
+	out = copy(head, head + strlen(head), out);
+	for(unsigned int row_idx = 0; row_idx < height; ++row_idx)
+	{
+		for(unsigned int col_idx = 0; col_idx < width; ++col_idx)
+		{
+			if(!getBlocked(col_idx, row_idx))
+				continue;
+
+			// Length of the run of blocked tiles starting here
+			unsigned int run_len = 1;
+			if(use_runs)
+			{
+				while(col_idx + run_len < width && getBlocked(col_idx + run_len, row_idx))
+					++run_len;
+			}
+
+			if(!first)
+			{
+				*out++ = ',';
+				*out++ = ' ';
+			}
+			first = false;
+			*out++ = '[';
+			out = to_chars(out, block_end, col_idx).ptr;
+			*out++ = ',';
+			*out++ = ' ';
+			out = to_chars(out, block_end, row_idx).ptr;
+			if(run_len > 1)
+			{
+				*out++ = ',';
+				*out++ = ' ';
+				out = to_chars(out, block_end, run_len).ptr;
+			}
+			*out++ = ']';
+			col_idx += run_len - 1;
+
+			if(out - &block[0] >= WRITE_BLOCK_BYTES)
+			{
+				out_file.write(&block[0], out - &block[0]);
+				out = &block[0];
+			}
+		}
+	}
+	out_file.write(&block[0], out - &block[0]);
+
+	out_file << "], \"robotStart\": [" << query.start.x << ", " << query.start.y << "]"
+	         << ", \"robotEnd\": [" << query.end.x << ", " << query.end.y << "]"
+	         << ", \"width\": " << width << ", \"height\": " << height << "}";
+
+	return out_file.good();
+}
+
+// Write the map in the binary format
+bool MapGenerator::writeBinary(const string &file_name, const PathQueryPair &query) const
+{
+	ofstream out_file(file_name.c_str(), ios::out | ios::binary);
+	if(!out_file.is_open())
+		return false;
+
+	// Header (all little-endian uint32)
+	uint32_t header[8] = { MAP_BINARY_MAGIC, MAP_BINARY_VERSION, width, height,
+	                       query.start.x, query.start.y, query.end.x, query.end.y };
+	char header_bytes[sizeof(header)];
+	for(unsigned int byte_idx = 0; byte_idx < sizeof(header); ++byte_idx)
+		header_bytes[byte_idx] = (char)((header[byte_idx/4] >> (8*(byte_idx%4))) & 0xFF);
+	out_file.write(header_bytes, sizeof(header_bytes));
+
+	// Obstacle rows (little-endian uint64 words), converted a block at a time
+	vector<char> block(WRITE_BLOCK_BYTES);
+	size_t num_words = obstacle_words.size();
+	size_t block_words = block.size() / 8;
+	for(size_t word_idx = 0; word_idx < num_words; word_idx += block_words)
+	{
+		size_t num_block_words = min(block_words, num_words - word_idx);
+		for(size_t block_idx = 0; block_idx < num_block_words; ++block_idx)
+		{
+			uint64_t word = obstacle_words[word_idx + block_idx];
+			for(unsigned int byte_idx = 0; byte_idx < 8; ++byte_idx)
+				block[block_idx*8 + byte_idx] = (char)((word >> (8*byte_idx)) & 0xFF);
+		}
+		out_file.write(&block[0], num_block_words*8);
+	}
+
+	return out_file.good();
+}
+
+// Write a query set
+bool MapGenerator::writeQueries(const string &file_name, const vector<PathQueryPair> &queries)
+{
+	ofstream out_file(file_name.c_str());
+	if(!out_file.is_open())
+		return false;
+
+	unsigned int num_queries = queries.size();
+	for(unsigned int query_idx = 0; query_idx < num_queries; ++query_idx)
+	{
+		out_file << queries[query_idx].start.x << "," << queries[query_idx].start.y << ","
+		         << queries[query_idx].end.x << "," << queries[query_idx].end.y << "\n";
+	}
+
+	return out_file.good();
+}
+
+// Convert a topology name
+bool MapGenerator::parseTopology(const string &name, MapTopology::Type &topology)
+{
+	if(name == "random")			topology = MapTopology::TOPO_RANDOM;
+	else if(name == "maze")			topology = MapTopology::TOPO_MAZE;
+	else if(name == "rooms")		topology = MapTopology::TOPO_ROOMS;
+	else if(name == "warehouse")	topology = MapTopology::TOPO_WAREHOUSE;
+	else							return false;
+
+	return true;
+}
+
+// splitmix64
+unsigned long long MapGenerator::nextRandom()
+{
+	unsigned long long z = (rng_state += 0x9E3779B97F4A7C15ULL);
+	z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+	z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+	return z ^ (z >> 31);
+}
+
+// Uniform value in [0, bound)
+unsigned int MapGenerator::randomBelow(unsigned int bound)
+{
+	// Multiply-shift (the bias is below 2^-32, negligible for map generation)
+	return (unsigned int)(((nextRandom() >> 32) * bound) >> 32);
+}
+
+// Set a rectangle of tiles
+void MapGenerator::fillRect(unsigned int x0, unsigned int y0, unsigned int rect_width, unsigned int rect_height, bool blocked)
+{
+	unsigned int x1 = min(x0 + rect_width, width);
+	unsigned int y1 = min(y0 + rect_height, height);
+	for(unsigned int row_idx = y0; row_idx < y1; ++row_idx)
+	{
+		uint64_t *row = &obstacle_words[(size_t)row_idx*row_words];
+		for(unsigned int col_idx = x0; col_idx < x1; ++col_idx)
+		{
+			uint64_t bit = (uint64_t)1 << (col_idx%MAP_WORD_BITS);
+			if(blocked)	row[col_idx/MAP_WORD_BITS] |= bit;
+			else		row[col_idx/MAP_WORD_BITS] &= ~bit;
+		}
+	}
+}
+
+// Random-density obstacles
+void MapGenerator::generateRandom(double density)
+{
+	// Compare each draw against density as a 64-bit fraction
+	unsigned long long threshold;
+	if(density <= 0.0)		return;
+	else if(density >= 1.0)	threshold = ~0ULL;
+	else					threshold = (unsigned long long)(density * 18446744073709551616.0);
+
+	for(unsigned int row_idx = 0; row_idx < height; ++row_idx)
+	{
+		uint64_t *row = &obstacle_words[(size_t)row_idx*row_words];
+		for(unsigned int col_idx = 0; col_idx < width; ++col_idx)
+		{
+			if(nextRandom() < threshold)
+				row[col_idx/MAP_WORD_BITS] |= (uint64_t)1 << (col_idx%MAP_WORD_BITS);
+		}
+	}
+}
+
+// Perfect maze (iterative recursive-backtracker)
+void MapGenerator::generateMaze()
+{
+	// Start solid, then carve cells and the walls between them
+	fillRect(0, 0, width, height, true);
+	if(width <= MAZE_CELL_SIZE || height <= MAZE_CELL_SIZE)
+		return;
+
+	unsigned int cell_cols = (width - 1) / MAZE_CELL_SIZE;
+	unsigned int cell_rows = (height - 1) / MAZE_CELL_SIZE;
+	unsigned int corridor = MAZE_CELL_SIZE - 1;
+	vector<bool> visited((size_t)cell_cols*cell_rows, false);
+	vector<unsigned int> cell_stack;
+
+	cell_stack.push_back(0);
+	visited[0] = true;
+	fillRect(1, 1, corridor, corridor, false);
+	while(!cell_stack.empty())
+	{
+		unsigned int cell = cell_stack.back();
+		unsigned int cell_x = cell % cell_cols;
+		unsigned int cell_y = cell / cell_cols;
+
+		// Collect the unvisited neighbours (up, right, down, left)
+		unsigned int neighbours[4], num_neighbours = 0;
+		if(cell_y > 0             && !visited[cell - cell_cols])	neighbours[num_neighbours++] = cell - cell_cols;
+		if(cell_x + 1 < cell_cols && !visited[cell + 1])			neighbours[num_neighbours++] = cell + 1;
+		if(cell_y + 1 < cell_rows && !visited[cell + cell_cols])	neighbours[num_neighbours++] = cell + cell_cols;
+		if(cell_x > 0             && !visited[cell - 1])			neighbours[num_neighbours++] = cell - 1;
+
+		if(num_neighbours == 0)
+		{
+			cell_stack.pop_back();
+			continue;
+		}
+
+		// Carve into a random one (the cell and the wall between them)
+		unsigned int next = neighbours[randomBelow(num_neighbours)];
+		unsigned int next_x = next % cell_cols;
+		unsigned int next_y = next / cell_cols;
+		unsigned int min_x = min(cell_x, next_x), min_y = min(cell_y, next_y);
+		fillRect(1 + min_x*MAZE_CELL_SIZE, 1 + min_y*MAZE_CELL_SIZE,
+		         corridor + (next_x != cell_x ? MAZE_CELL_SIZE : 0),
+		         corridor + (next_y != cell_y ? MAZE_CELL_SIZE : 0), false);
+
+		visited[next] = true;
+		cell_stack.push_back(next);
+	}
+}
+
+// Rooms joined by corridors
+void MapGenerator::generateRooms()
+{
+	fillRect(0, 0, width, height, true);
+	if(width <= ROOM_MAX_SIZE + 2 || height <= ROOM_MAX_SIZE + 2)
+	{
+		// Too small for the room layout, make it one room
+		if(width > 2 && height > 2)
+			fillRect(1, 1, width - 2, height - 2, false);
+		return;
+	}
+
+	// Place rooms that don't touch an existing room
+	vector<PosTile> room_centers;
+	unsigned long long num_tries = ((unsigned long long)width*height) / ROOM_AREA_PER_TRY + 1;
+	for(unsigned long long try_idx = 0; try_idx < num_tries; ++try_idx)
+	{
+		unsigned int room_width  = ROOM_MIN_SIZE + randomBelow(ROOM_MAX_SIZE - ROOM_MIN_SIZE + 1);
+		unsigned int room_height = ROOM_MIN_SIZE + randomBelow(ROOM_MAX_SIZE - ROOM_MIN_SIZE + 1);
+		unsigned int x0 = 1 + randomBelow(width - room_width - 1);
+		unsigned int y0 = 1 + randomBelow(height - room_height - 1);
+
+		// Check the room plus a 1-tile wall is still solid
+		bool overlaps = false;
+		for(unsigned int row_idx = y0 - 1; row_idx <= y0 + room_height && !overlaps; ++row_idx)
+			for(unsigned int col_idx = x0 - 1; col_idx <= x0 + room_width && !overlaps; ++col_idx)
+				overlaps = !getBlocked(col_idx, row_idx);
+		if(overlaps)
+			continue;
+
+		fillRect(x0, y0, room_width, room_height, false);
+		PosTile center = { x0 + room_width/2, y0 + room_height/2 };
+		room_centers.push_back(center);
+	}
+
+	// Join each room to the one placed before it with an L-shaped corridor
+	// (placement order is random, so the corridors criss-cross the whole map)
+	unsigned int num_rooms = room_centers.size();
+	for(unsigned int room_idx = 1; room_idx < num_rooms; ++room_idx)
+	{
+		const PosTile &from = room_centers[room_idx - 1];
+		const PosTile &to   = room_centers[room_idx];
+		unsigned int min_x = min(from.x, to.x), max_x = max(from.x, to.x);
+		unsigned int min_y = min(from.y, to.y), max_y = max(from.y, to.y);
+
+		fillRect(min_x, from.y, max_x - min_x + CORRIDOR_WIDTH, CORRIDOR_WIDTH, false);
+		fillRect(to.x, min_y, CORRIDOR_WIDTH, max_y - min_y + CORRIDOR_WIDTH, false);
+	}
+
+	// Keep the outer wall solid
+	fillRect(0, 0, width, 1, true);
+	fillRect(0, height - 1, width, 1, true);
+	fillRect(0, 0, 1, height, true);
+	fillRect(width - 1, 0, 1, height, true);
+}
+
+// Warehouse racks and aisles
+void MapGenerator::generateWarehouse()
+{
+	// Outer wall
+	fillRect(0, 0, width, 1, true);
+	fillRect(0, height - 1, width, 1, true);
+	fillRect(0, 0, 1, height, true);
+	fillRect(width - 1, 0, 1, height, true);
+
+	// Blocks of racks below the dock, separated by aisles (x) and cross-aisles (y)
+	for(unsigned int y0 = 1 + DOCK_DEPTH; y0 + RACK_LENGTH + 1 < height; y0 += RACK_LENGTH + CROSS_AISLE_WIDTH)
+	{
+		for(unsigned int x0 = 1 + AISLE_WIDTH; x0 + RACK_WIDTH + 1 < width; x0 += RACK_WIDTH + AISLE_WIDTH)
+		{
+			if(randomBelow(100) < RACK_GAP_PERCENT)
+				continue;
+			fillRect(x0, y0, RACK_WIDTH, RACK_LENGTH, true);
+		}
+	}
+}
@@ -0,0 +1,360 @@
+/**
+ * MemProfile.cpp
+ *  Created on: Oct 18, 2026
+ *      Author: iRobot maintainers
+ *     Purpose: Allocation and memory-footprint profiling (Includes.h MEM_PROFILE '1')
+ *              Replaces the global operator new/delete with versions that put a small header
+ *              in front of each block, recording its size and the subsystem it was charged to
+ */
+#include "../headers/MemProfile.hpp"
+
+#if MEM_PROFILE
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <new>
+
+using namespace std;
+
+// Header just in front of every profiled block (16 bytes, so blocks stay 16-byte aligned)
+struct AllocHeader
+{
+	uint64_t size;
+	uint32_t subsystem;
+	uint32_t offset;	// From the start of the malloc()ed memory to the block
+};
+
+// Per-subsystem counters
+static atomic<uint64_t> alloc_counts[MemSubsystem::NUM_SUBSYSTEMS];
+static atomic<uint64_t> alloc_bytes[MemSubsystem::NUM_SUBSYSTEMS];
+static atomic<uint64_t> live_bytes[MemSubsystem::NUM_SUBSYSTEMS];
+static atomic<uint64_t> peak_live_bytes[MemSubsystem::NUM_SUBSYSTEMS];
+
+// Subsystem the current thread's allocations are charged to
+static thread_local MemSubsystem::Type cur_subsystem = MemSubsystem::MEM_OTHER;
+
+// Recorded phases
+struct PhaseRecord
+{
+	const char *name;
+	long peak_rss_kb, end_rss_kb;
+	uint64_t num_allocs, num_bytes;
+};
+static PhaseRecord phase_records[MEM_MAX_PHASES];
+static atomic<unsigned int> num_phases(0);
+
+// Open list high-water marks per engine
+struct EngineRecord
+{
+	const char *name;
+	uint64_t num_searches, high_water;
+	size_t entry_bytes;
+};
+static EngineRecord engine_records[MEM_MAX_ENGINES];
+static unsigned int num_engines = 0;
+static mutex engine_mutex;
+
+/**
+ * Function: totalCounts()
+ *
+ * @param bytes The return bytes allocated by every subsystem so far
+ * @return uint64_t Number of allocations by every subsystem so far
+ */
+static uint64_t totalCounts(uint64_t &bytes)
+{
+	uint64_t count = 0;
+	bytes = 0;
+	for(unsigned int sub_idx = 0; sub_idx < MemSubsystem::NUM_SUBSYSTEMS; ++sub_idx)
+	{
+		count += alloc_counts[sub_idx];
+		bytes += alloc_bytes[sub_idx];
+	}
+	return count;
+}
+
+/**
+ * Function: readStatusKb()
+ *
+ * @param field The /proc/self/status field (e.g. "VmHWM:")
+ * @return long The field's value in kB (-1 if unavailable)
+ */
+static long readStatusKb(const char *field)
+{
+	FILE *status_file = fopen("/proc/self/status", "r");
+	if(status_file == NULL)
+		return -1;
+
+	char line[256];
+	long value = -1;
+	size_t field_len = strlen(field);
+	while(fgets(line, sizeof(line), status_file) != NULL)
+	{
+		if(strncmp(line, field, field_len) == 0)
+		{
+			value = strtol(line + field_len, NULL, 10);
+			break;
+		}
+	}
+	fclose(status_file);
+	return value;
+}
+
+/**
+ * Function: profiledAlloc(), profiledFree()
+ * Use: The allocation hooks behind every operator new/delete
+ *      (over-aligned blocks leave a gap before the header)
+ */
+static void *profiledAlloc(size_t size, size_t alignment = sizeof(AllocHeader))
+{
+	// Room for the header whatever malloc()'s own alignment is (it may be less than 'alignment')
+	alignment = max(alignment, sizeof(AllocHeader));
+	char *raw = (char *)malloc(size + alignment + sizeof(AllocHeader));
+	if(raw == NULL)
+		return NULL;
+	char *block = (char *)(((uintptr_t)raw + sizeof(AllocHeader) + alignment - 1) & ~(uintptr_t)(alignment - 1));
+	AllocHeader *header = (AllocHeader *)block - 1;
+	header->size = size;
+	header->subsystem = cur_subsystem;
+	header->offset = block - raw;
+
+	++alloc_counts[cur_subsystem];
+	alloc_bytes[cur_subsystem] += size;
+	uint64_t now_live = (live_bytes[cur_subsystem] += size);
+	uint64_t prev_peak = peak_live_bytes[cur_subsystem];
+	while(now_live > prev_peak && !peak_live_bytes[cur_subsystem].compare_exchange_weak(prev_peak, now_live))
+		;
+	return block;
+}
+
+static void profiledFree(void *ptr)
+{
+	if(ptr == NULL)
+		return;
+	AllocHeader *header = (AllocHeader *)ptr - 1;
+	live_bytes[header->subsystem] -= header->size;
+	free((char *)ptr - header->offset);
+}
+
+// Scopes
+MemScope::MemScope(MemSubsystem::Type subsystem)
+: prev_subsystem(cur_subsystem)
+{
+	cur_subsystem = subsystem;
+}
+
+MemScope::~MemScope()
+{
+	cur_subsystem = prev_subsystem;
+}
+
+// Phases
+MemPhase::MemPhase(const char *phase_name_arg)
+: phase_name(phase_name_arg), ended(false)
+{
+	// Writing '5' resets VmHWM to the current RSS (Linux 4.0+), so the peak is this phase's own
+	FILE *clear_file = fopen("/proc/self/clear_refs", "w");
+	if(clear_file != NULL)
+	{
+		fputs("5", clear_file);
+		fclose(clear_file);
+	}
+	begin_count = totalCounts(begin_bytes);
+}
+
+MemPhase::~MemPhase()
+{
+	end();
+}
+
+void MemPhase::end()
+{
+	if(ended)
+		return;
+	ended = true;
+
+	unsigned int phase_idx = num_phases++;
+	if(phase_idx >= MEM_MAX_PHASES)
+		return;
+
+	uint64_t end_bytes = 0, end_count = totalCounts(end_bytes);
+	PhaseRecord &record = phase_records[phase_idx];
+	record.name = phase_name;
+	record.peak_rss_kb = readStatusKb("VmHWM:");
+	record.end_rss_kb = readStatusKb("VmRSS:");
+	record.num_allocs = end_count - begin_count;
+	record.num_bytes = end_bytes - begin_bytes;
+}
+
+// Open list high-water marks
+void memRecordOpenList(const char *engine_name, size_t high_water, size_t entry_bytes)
+{
+	lock_guard<mutex> engine_lock(engine_mutex);
+	unsigned int engine_idx = 0;
+	while(engine_idx < num_engines && engine_records[engine_idx].name != engine_name)
+		++engine_idx;
+	if(engine_idx == num_engines)
+	{
+		if(num_engines == MEM_MAX_ENGINES)
+			return;
+		EngineRecord new_record = { engine_name, 0, 0, entry_bytes };
+		engine_records[num_engines++] = new_record;
+	}
+
+	++engine_records[engine_idx].num_searches;
+	engine_records[engine_idx].high_water = max<uint64_t>(engine_records[engine_idx].high_water, high_water);
+}
+
+// Allocation count of a subsystem
+uint64_t memGetAllocCount(MemSubsystem::Type subsystem)
+{
+	return alloc_counts[subsystem];
+}
+
+// Print the report
+void memPrintReport()
+{
+	const char *subsystem_names[MemSubsystem::NUM_SUBSYSTEMS] = { "other", "loader", "map", "search", "output" };
+
+	cout << "Memory profile:" << endl;
+	cout << "\tsubsystem: allocations, bytes allocated, peak live bytes, live bytes at exit" << endl;
+	for(unsigned int sub_idx = 0; sub_idx < MemSubsystem::NUM_SUBSYSTEMS; ++sub_idx)
+	{
+		cout << "\t" << subsystem_names[sub_idx] << ": " << alloc_counts[sub_idx] << ", " << alloc_bytes[sub_idx]
+		     << ", " << peak_live_bytes[sub_idx] << ", " << live_bytes[sub_idx] << endl;
+	}
+
+	unsigned int phases_kept = min(num_phases.load(), (unsigned int)MEM_MAX_PHASES);
+	for(unsigned int phase_idx = 0; phase_idx < phases_kept; ++phase_idx)
+	{
+		const PhaseRecord &record = phase_records[phase_idx];
+		cout << "\tphase " << record.name << ": peak RSS " << record.peak_rss_kb << " kB, RSS at end "
+		     << record.end_rss_kb << " kB, " << record.num_allocs << " allocations (" << record.num_bytes
+		     << " bytes)" << endl;
+	}
+
+	lock_guard<mutex> engine_lock(engine_mutex);
+	for(unsigned int engine_idx = 0; engine_idx < num_engines; ++engine_idx)
+	{
+		const EngineRecord &record = engine_records[engine_idx];
+		cout << "\tOpen list " << record.name << ": " << record.num_searches << " searches, high-water mark "
+		     << record.high_water << " entries (" << record.high_water*record.entry_bytes << " bytes)" << endl;
+	}
+}
+
+// Print the report at exit
+static struct MemReportAtExit
+{
+	MemReportAtExit() { atexit(memPrintReport); }
+} mem_report_at_exit;
+
+//---------------------------------------------------------------------
+// Global allocation functions (every other form forwards to these)
+//---------------------------------------------------------------------
+void *operator new(size_t size)
+{
+	void *ptr = profiledAlloc(size);
+	if(ptr == NULL)
+		throw bad_alloc();
+	return ptr;
+}
+
+void *operator new[](size_t size)
+{
+	return operator new(size);
+}
+
+void *operator new(size_t size, const nothrow_t &) noexcept
+{
+	return profiledAlloc(size);
+}
+
+void *operator new[](size_t size, const nothrow_t &) noexcept
+{
+	return profiledAlloc(size);
+}
+
+void *operator new(size_t size, align_val_t alignment)
+{
+	void *ptr = profiledAlloc(size, (size_t)alignment);
+	if(ptr == NULL)
+		throw bad_alloc();
+	return ptr;
+}
+
+void *operator new[](size_t size, align_val_t alignment)
+{
+	return operator new(size, alignment);
+}
+
+void *operator new(size_t size, align_val_t alignment, const nothrow_t &) noexcept
+{
+	return profiledAlloc(size, (size_t)alignment);
+}
+
+void *operator new[](size_t size, align_val_t alignment, const nothrow_t &) noexcept
+{
+	return profiledAlloc(size, (size_t)alignment);
+}
+
+void operator delete(void *ptr) noexcept
+{
+	profiledFree(ptr);
+}
+
+void operator delete[](void *ptr) noexcept
+{
+	profiledFree(ptr);
+}
+
+void operator delete(void *ptr, size_t) noexcept
+{
+	profiledFree(ptr);
+}
+
+void operator delete[](void *ptr, size_t) noexcept
+{
+	profiledFree(ptr);
+}
+
+void operator delete(void *ptr, const nothrow_t &) noexcept
+{
+	profiledFree(ptr);
+}
+
+void operator delete[](void *ptr, const nothrow_t &) noexcept
+{
+	profiledFree(ptr);
+}
+
+void operator delete(void *ptr, align_val_t) noexcept
+{
+	profiledFree(ptr);
+}
+
+void operator delete[](void *ptr, align_val_t) noexcept
+{
+	profiledFree(ptr);
+}
+
+void operator delete(void *ptr, size_t, align_val_t) noexcept
+{
+	profiledFree(ptr);
+}
+
+void operator delete[](void *ptr, size_t, align_val_t) noexcept
+{
+	profiledFree(ptr);
+}
+
+void operator delete(void *ptr, align_val_t, const nothrow_t &) noexcept
+{
+	profiledFree(ptr);
+}
+
+void operator delete[](void *ptr, align_val_t, const nothrow_t &) noexcept
+{
+	profiledFree(ptr);
+}
+
+#endif
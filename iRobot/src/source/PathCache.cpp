@@ -0,0 +1,269 @@
+/**
+ * PathCache.cpp
+ *  Created on: Oct 18, 2026
+ *      Author: iRobot maintainers
+ *     Purpose: LRU cache of finished A* results, bounded by memory
+ */
+#include "../headers/PathCache.hpp"
+#include "../headers/AStar.hpp"
+
+using namespace std;
+
+// Rough per-node overhead of the standard containers (pointers + allocator header)
+#define CONTAINER_NODE_BYTES	32
+
+// Initialization constructor
+PathCache::PathCache(size_t max_bytes_arg)
+: cache_version(0), max_radius(0.0f), max_bytes(max_bytes_arg)
+{
+	stats.hits = 0;
+	stats.misses = 0;
+	stats.evictions = 0;
+	stats.invalidations = 0;
+	stats.bytes_used = 0;
+}
+
+// Destructor
+PathCache::~PathCache()
+{
+
+}
+
+// Return the path, running A* on a miss
+bool PathCache::findPath(const GameMap &game_map, const PosTile &start, const PosTile &end, float robot_radius,
+                         shared_ptr<const vector<PosTile> > &path)
+{
+	PathQuery query = { start, end, robot_radius };
+	if(lookup(game_map.getVersion(), query, path))
+		return !path->empty();
+
+	// Not cached, run the search to completion (in the arena, freed by the next miss)
+	search_arena.reset();
+	AStar a_star(game_map, start, end, robot_radius, &search_arena);
+	SearchStatus::Type status = SearchStatus::SEARCH_RUNNING;
+	while(status == SearchStatus::SEARCH_RUNNING)
+		status = a_star.advance(10000);
+
+	shared_ptr<vector<PosTile> > new_path = make_shared<vector<PosTile> >();
+	if(status == SearchStatus::SEARCH_FOUND)
+		a_star.getPath(*new_path);
+
+	path = new_path;
+	insert(game_map.getVersion(), query, path);
+	return !path->empty();
+}
+
+// Fetch a cached result
+bool PathCache::lookup(unsigned long map_version, const PathQuery &query, shared_ptr<const vector<PosTile> > &path)
+{
+	unordered_map<PathQuery, EntryIt, PathQueryHash>::iterator map_it = entries.find(query);
+	if(map_version != cache_version || map_it == entries.end())
+	{
+		++stats.misses;
+		return false;
+	}
+
+	// Move it to the front of the LRU list (iterators stay valid)
+	lru_list.splice(lru_list.begin(), lru_list, map_it->second);
+
+	++stats.hits;
+	path = map_it->second->path;
+	return true;
+}
+
+// Add a result to the cache
+void PathCache::insert(unsigned long map_version, const PathQuery &query, const shared_ptr<const vector<PosTile> > &path)
+{
+	// The entries are only valid for their own version
+	if(map_version != cache_version)
+	{
+		stats.invalidations += lru_list.size();
+		clear();
+		cache_version = map_version;
+	}
+
+	// Replace any older result for the same query
+	unordered_map<PathQuery, EntryIt, PathQueryHash>::iterator map_it = entries.find(query);
+	if(map_it != entries.end())
+		removeEntry(map_it->second);
+
+	// Find the index cells the path passes through
+	CacheEntry new_entry;
+	new_entry.query = query;
+	new_entry.path = path;
+	unsigned int path_size = path->size();
+	for(unsigned int path_idx = 0; path_idx < path_size; ++path_idx)
+	{
+		unsigned long cell_id = getCellId((*path)[path_idx].x, (*path)[path_idx].y);
+		if(new_entry.cells.empty() || new_entry.cells.back() != cell_id)
+			new_entry.cells.push_back(cell_id);
+	}
+	sort(new_entry.cells.begin(), new_entry.cells.end());
+	new_entry.cells.erase(unique(new_entry.cells.begin(), new_entry.cells.end()), new_entry.cells.end());
+
+	new_entry.bytes = sizeof(CacheEntry) + 3*CONTAINER_NODE_BYTES +
+	                  path_size*sizeof(PosTile) +
+	                  new_entry.cells.size()*(sizeof(unsigned long) + CONTAINER_NODE_BYTES);
+	if(new_entry.bytes > max_bytes)
+		return;
+
+	// Make room
+	while(!lru_list.empty() && stats.bytes_used + new_entry.bytes > max_bytes)
+	{
+		removeEntry(--lru_list.end());
+		++stats.evictions;
+	}
+
+	// Add it to the front of the LRU list, the key lookup, and the spatial index
+	lru_list.push_front(new_entry);
+	EntryIt entry_it = lru_list.begin();
+	CacheEntry *entry = &(*entry_it);
+	entries[query] = entry_it;
+
+	unsigned int num_cells = entry->cells.size();
+	for(unsigned int cell_idx = 0; cell_idx < num_cells; ++cell_idx)
+		cell_index[entry->cells[cell_idx]].insert(entry);
+	if(path->empty())
+		unreachable_entries.insert(entry);
+
+	max_radius = max(max_radius, query.robot_radius);
+	stats.bytes_used += entry->bytes;
+}
+
+// Carry the cache over an obstacle update
+void PathCache::onObstacleUpdate(unsigned long old_version, unsigned long new_version,
+                                 const vector<PosTile> &tiles, bool traversable)
+{
+	// Entries from before an update the cache never saw can't be trusted
+	if(old_version != cache_version)
+	{
+		stats.invalidations += lru_list.size();
+		clear();
+		cache_version = new_version;
+		return;
+	}
+
+	// Collect the entries that the update affects
+	unordered_set<CacheEntry *> affected;
+	if(traversable)
+	{
+		// Opening tiles can only turn "no path" into a path
+		affected = unreachable_entries;
+	}
+	else if(!tiles.empty())
+	{
+		// A new obstacle blocks paths within robot radius of it, so gather the entries in
+		// every index cell within the largest radius of an updated tile
+		unsigned int reach = (unsigned int)ceil(max_radius);
+		unordered_set<unsigned long> cells;
+		PosTile low = tiles[0], high = tiles[0];
+		unsigned int num_tiles = tiles.size();
+		for(unsigned int tile_idx = 0; tile_idx < num_tiles; ++tile_idx)
+		{
+			const PosTile &tile = tiles[tile_idx];
+			low.x = min(low.x, tile.x);
+			low.y = min(low.y, tile.y);
+			high.x = max(high.x, tile.x);
+			high.y = max(high.y, tile.y);
+
+			unsigned int min_x = (tile.x > reach) ? tile.x - reach : 0;
+			unsigned int min_y = (tile.y > reach) ? tile.y - reach : 0;
+			for(unsigned int cell_y = min_y / CACHE_CELL_SIZE; cell_y <= (tile.y + reach) / CACHE_CELL_SIZE; ++cell_y)
+				for(unsigned int cell_x = min_x / CACHE_CELL_SIZE; cell_x <= (tile.x + reach) / CACHE_CELL_SIZE; ++cell_x)
+					cells.insert(getCellId(cell_x*CACHE_CELL_SIZE, cell_y*CACHE_CELL_SIZE));
+		}
+
+		unordered_set<CacheEntry *> candidates;
+		for(unordered_set<unsigned long>::iterator cell_id_it = cells.begin(); cell_id_it != cells.end(); ++cell_id_it)
+		{
+			unordered_map<unsigned long, unordered_set<CacheEntry *> >::iterator cell_it = cell_index.find(*cell_id_it);
+			if(cell_it != cell_index.end())
+				candidates.insert(cell_it->second.begin(), cell_it->second.end());
+		}
+
+		// Then check each of their paths once against the update
+		for(unordered_set<CacheEntry *>::iterator it = candidates.begin(); it != candidates.end(); ++it)
+		{
+			if(pathNearTiles(**it, tiles, low, high))
+				affected.insert(*it);
+		}
+	}
+
+	// Drop the affected entries; everything else is still valid for the new version
+	for(unordered_set<CacheEntry *>::iterator it = affected.begin(); it != affected.end(); ++it)
+	{
+		removeEntry(entries[(*it)->query]);
+		++stats.invalidations;
+	}
+	cache_version = new_version;
+}
+
+// Drop every entry
+void PathCache::clear()
+{
+	lru_list.clear();
+	entries.clear();
+	cell_index.clear();
+	unreachable_entries.clear();
+	max_radius = 0.0f;
+	stats.bytes_used = 0;
+}
+
+// Print the counters
+void PathCache::printStats(ostream &out) const
+{
+	out << "Path cache: " << lru_list.size() << " entries, " << stats.bytes_used << "/" << max_bytes << " bytes" << endl;
+	out << "\thits: " << stats.hits << ", misses: " << stats.misses
+	    << ", hit rate: " << stats.getHitRate()*100.0 << "%" << endl;
+	out << "\tevictions: " << stats.evictions << ", invalidations: " << stats.invalidations << endl;
+	out << "\tsearch arena: " << search_arena.getCapacity() << " bytes, peak use " << search_arena.getPeak()
+	    << " bytes, " << search_arena.getNumHeapAllocs() << " blocks allocated" << endl;
+}
+
+// Drop an entry
+void PathCache::removeEntry(EntryIt entry_it)
+{
+	CacheEntry *entry = &(*entry_it);
+
+	unsigned int num_cells = entry->cells.size();
+	for(unsigned int cell_idx = 0; cell_idx < num_cells; ++cell_idx)
+	{
+		unordered_map<unsigned long, unordered_set<CacheEntry *> >::iterator cell_it = cell_index.find(entry->cells[cell_idx]);
+		cell_it->second.erase(entry);
+		if(cell_it->second.empty())
+			cell_index.erase(cell_it);
+	}
+	unreachable_entries.erase(entry);
+
+	stats.bytes_used -= entry->bytes;
+	entries.erase(entry->query);
+	lru_list.erase(entry_it);
+}
+
+// Check whether obstacles at 'tiles' block the path
+bool PathCache::pathNearTiles(const CacheEntry &entry, const vector<PosTile> &tiles, const PosTile &low,
+                              const PosTile &high)
+{
+	float radius = entry.query.robot_radius;
+	unsigned int path_size = entry.path->size();
+	unsigned int num_tiles = tiles.size();
+	for(unsigned int path_idx = 0; path_idx < path_size; ++path_idx)
+	{
+		// Only path tiles within radius of the updated tiles' bounding box need the full check
+		const PosTile &path_tile = (*entry.path)[path_idx];
+		if((float)path_tile.x + radius < (float)low.x || (float)path_tile.x > (float)high.x + radius ||
+		   (float)path_tile.y + radius < (float)low.y || (float)path_tile.y > (float)high.y + radius)
+			continue;
+
+		for(unsigned int tile_idx = 0; tile_idx < num_tiles; ++tile_idx)
+		{
+			float dx = (float)path_tile.x - (float)tiles[tile_idx].x;
+			float dy = (float)path_tile.y - (float)tiles[tile_idx].y;
+			float sq_dist = dx*dx + dy*dy;
+			if(sq_dist == 0.0f || sq_dist < radius*radius)
+				return true;
+		}
+	}
+
+	return false;
+}
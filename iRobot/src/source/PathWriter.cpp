@@ -0,0 +1,114 @@
+/**
+ * PathWriter.cpp
+ *  Created on: Oct 18, 2026
+ *      Author: iRobot maintainers
+ *     Purpose: Formats paths into a reusable, preallocated output buffer
+ */
+#include "../headers/PathWriter.hpp"
+
+using namespace std;
+
+// Initialization constructor
+PathWriter::PathWriter(size_t initial_capacity)
+: buffer(max(initial_capacity, (size_t)1)), buffer_size(0)
+{
+
+}
+
+// Destructor
+PathWriter::~PathWriter()
+{
+
+}
+
+// Append raw text
+void PathWriter::appendText(const string &text)
+{
+	char *out = reserve(text.size());
+	memcpy(out, text.data(), text.size());
+	buffer_size += text.size();
+}
+
+// Append a path
+void PathWriter::appendPath(const vector<PosTile> &path, PathFormat::Type format, bool waypoints_only)
+{
+	const vector<PosTile> *out_path = &path;
+	if(waypoints_only)
+	{
+		getWaypoints(path, waypoints);
+		out_path = &waypoints;
+	}
+	unsigned int num_points = out_path->size();
+
+	if(format == PathFormat::FORMAT_BINARY)
+	{
+		// Header: magic, flags (bit 0 = waypoints only), point count
+		appendUInt32(PATH_BINARY_MAGIC);
+		appendUInt32(waypoints_only ? 1 : 0);
+		appendUInt32(num_points);
+
+		char *out = reserve(num_points*2*sizeof(uint32_t));
+		for(unsigned int point_idx = 0; point_idx < num_points; ++point_idx)
+		{
+			uint32_t coords[2] = { (*out_path)[point_idx].x, (*out_path)[point_idx].y };
+			for(unsigned int byte_idx = 0; byte_idx < 8; ++byte_idx)
+				*out++ = (char)((coords[byte_idx/4] >> (8*(byte_idx%4))) & 0xFF);
+		}
+		buffer_size += num_points*2*sizeof(uint32_t);
+		return;
+	}
+
+	// Text: one "x,y" line per point, formatted straight into the buffer
+	char *out = reserve(num_points*PATH_MAX_LINE_CHARS);
+	char *out_end = out + num_points*PATH_MAX_LINE_CHARS;
+	char *out_start = out;
+	for(unsigned int point_idx = 0; point_idx < num_points; ++point_idx)
+	{
+		out = to_chars(out, out_end, (*out_path)[point_idx].x).ptr;
+		*out++ = ',';
+		out = to_chars(out, out_end, (*out_path)[point_idx].y).ptr;
+		*out++ = '\n';
+	}
+	buffer_size += out - out_start;
+}
+
+// Compress a path to its turn points
+void PathWriter::getWaypoints(const vector<PosTile> &path, vector<PosTile> &waypoints)
+{
+	waypoints.clear();
+	unsigned int path_size = path.size();
+	if(path_size == 0)
+		return;
+
+	waypoints.push_back(path[0]);
+	for(unsigned int path_idx = 1; path_idx + 1 < path_size; ++path_idx)
+	{
+		// Keep the tile if the step into it and the step out of it differ
+		int in_dx  = (int)path[path_idx].x - (int)path[path_idx - 1].x;
+		int in_dy  = (int)path[path_idx].y - (int)path[path_idx - 1].y;
+		int out_dx = (int)path[path_idx + 1].x - (int)path[path_idx].x;
+		int out_dy = (int)path[path_idx + 1].y - (int)path[path_idx].y;
+		if(in_dx != out_dx || in_dy != out_dy)
+			waypoints.push_back(path[path_idx]);
+	}
+	if(path_size > 1)
+		waypoints.push_back(path[path_size - 1]);
+}
+
+// Make room for more bytes
+char *PathWriter::reserve(size_t num_bytes)
+{
+	if(buffer_size + num_bytes > buffer.size())
+		buffer.resize(max(buffer.size()*2, buffer_size + num_bytes));
+
+	return &buffer[buffer_size];
+}
+
+// Append a little-endian 32-bit value
+void PathWriter::appendUInt32(uint32_t value)
+{
+	char *out = reserve(sizeof(uint32_t));
+	for(unsigned int byte_idx = 0; byte_idx < sizeof(uint32_t); ++byte_idx)
+		out[byte_idx] = (char)((value >> (8*byte_idx)) & 0xFF);
+	buffer_size += sizeof(uint32_t);
+}
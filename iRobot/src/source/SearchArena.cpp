@@ -0,0 +1,92 @@
+/**
+ * SearchArena.cpp
+ *  Created on: Oct 18, 2026
+ *      Author: iRobot maintainers
+ *     Purpose: Bump allocator for per-query search state
+ */
+#include "../headers/SearchArena.hpp"
+
+using namespace std;
+
+// Initialization constructor
+SearchArena::SearchArena(size_t initial_bytes)
+: head(NULL), cur(NULL), end(NULL), capacity(0), used(0), peak(0), num_heap_allocs(0)
+{
+	if(initial_bytes > 0)
+		addBlock(initial_bytes);
+}
+
+// Destructor
+SearchArena::~SearchArena()
+{
+	freeBlocks();
+}
+
+// Take back every allocation
+void SearchArena::reset()
+{
+	// Merge the blocks into one, so the same query next time fits without a heap allocation
+	if(head != NULL && head->next != NULL)
+	{
+		size_t total_bytes = capacity;
+		freeBlocks();
+		addBlock(total_bytes);
+	}
+	else if(head != NULL)
+	{
+		cur = (char *)(head + 1);
+	}
+	used = 0;
+}
+
+// Get a new block from the heap
+void SearchArena::addBlock(size_t min_bytes)
+{
+	// Grow geometrically, so a large query takes few blocks
+	size_t block_bytes = max(min_bytes + sizeof(Block), max(capacity, (size_t)ARENA_MIN_BLOCK_BYTES));
+	Block *new_block = (Block *)new char[block_bytes];
+	new_block->next = head;
+	new_block->size = block_bytes;
+	head = new_block;
+	cur = (char *)(new_block + 1);
+	end = (char *)new_block + block_bytes;
+
+	capacity += block_bytes;
+	++num_heap_allocs;
+}
+
+// Return every block to the heap
+void SearchArena::freeBlocks()
+{
+	while(head != NULL)
+	{
+		Block *next_block = head->next;
+		delete[] (char *)head;
+		head = next_block;
+	}
+	cur = NULL;
+	end = NULL;
+	capacity = 0;
+}
+
+// Hand out 'bytes' from the current block
+void *SearchArena::do_allocate(size_t bytes, size_t alignment)
+{
+	uintptr_t aligned = ((uintptr_t)cur + alignment - 1) & ~(uintptr_t)(alignment - 1);
+	if(cur == NULL || aligned + bytes > (uintptr_t)end)
+	{
+		addBlock(bytes + alignment);
+		aligned = ((uintptr_t)cur + alignment - 1) & ~(uintptr_t)(alignment - 1);
+	}
+
+	cur = (char *)(aligned + bytes);
+	used += bytes;
+	peak = max(peak, used);
+	return (void *)aligned;
+}
+
+// Freed memory only comes back on reset()
+void SearchArena::do_deallocate(void *, size_t, size_t)
+{
+
+}
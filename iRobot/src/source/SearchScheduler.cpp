@@ -0,0 +1,68 @@
+/**
+ * SearchScheduler.cpp
+ *  Created on: Oct 18, 2026
+ *      Author: iRobot maintainers
+ *     Purpose: Shares one thread between many resumable A* searches
+ */
+#include "../headers/SearchScheduler.hpp"
+
+using namespace std;
+
+// Initialization constructor
+SearchScheduler::SearchScheduler(unsigned long quantum_arg)
+: quantum(quantum_arg)
+{
+
+}
+
+// Destructor
+SearchScheduler::~SearchScheduler()
+{
+
+}
+
+// Add a search to the round-robin
+void SearchScheduler::addSearch(AStar *search)
+{
+	if(search->getStatus() == SearchStatus::SEARCH_RUNNING)
+		active_searches.push_back(search);
+}
+
+// Remove a search from the round-robin
+void SearchScheduler::removeSearch(AStar *search)
+{
+	active_searches.erase(remove(active_searches.begin(), active_searches.end(), search),
+	                      active_searches.end());
+}
+
+// Advance every active search by one quantum
+unsigned int SearchScheduler::runSlice()
+{
+	unsigned int num_searches = active_searches.size();
+	for(unsigned int search_idx = 0; search_idx < num_searches; ++search_idx)
+	{
+		// Take the next search off the front, and requeue it at the back if it's still running
+		AStar *search = active_searches.front();
+		active_searches.pop_front();
+
+		if(search->advance(quantum) == SearchStatus::SEARCH_RUNNING)
+			active_searches.push_back(search);
+	}
+
+	return active_searches.size();
+}
+
+// Advance the active searches until the deadline passes
+unsigned int SearchScheduler::runUntil(const chrono::steady_clock::time_point &deadline)
+{
+	while(!active_searches.empty() && chrono::steady_clock::now() < deadline)
+	{
+		AStar *search = active_searches.front();
+		active_searches.pop_front();
+
+		if(search->advance(quantum) == SearchStatus::SEARCH_RUNNING)
+			active_searches.push_back(search);
+	}
+
+	return active_searches.size();
+}
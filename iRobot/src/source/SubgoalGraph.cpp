@@ -0,0 +1,583 @@
+/**
+ * SubgoalGraph.cpp
+ *  Created on: Oct 18, 2026
+ *      Author: iRobot maintainers
+ *     Purpose: Preprocessed pathfinding for static maps (Simple Subgoal Graphs)
+ */
+#include "../headers/SubgoalGraph.hpp"
+#include "../headers/Parallel.hpp"
+#include "../headers/MemProfile.hpp"
+
+#include <queue>
+
+using namespace std;
+
+// Tolerance for comparing summed float costs
+#define COST_EPSILON	1.0e-3f
+
+// Straight and diagonal scan directions
+static const int STRAIGHT_DX[4] = { 1, -1, 0,  0 };
+static const int STRAIGHT_DY[4] = { 0,  0, 1, -1 };
+static const int DIAG_DX[4] = { 1,  1, -1, -1 };
+static const int DIAG_DY[4] = { 1, -1,  1, -1 };
+
+// Every cost is a whole number of 1/COST_UNITS steps (1 = 5/5, 1.4 = 7/5), so F can be
+// compared exactly as an integer, and ties broken properly
+#define COST_UNITS	5.0f
+
+// A* open list entry (lowest F first, then largest G, which heads straight for the goal
+// instead of fanning out over the many equally short routes of a grid)
+struct FlatEntry
+{
+	uint32_t F_units;
+	float G;
+	uint32_t node;
+	bool operator <(const FlatEntry &other) const
+	{
+		return (F_units != other.F_units) ? (F_units > other.F_units) : (G < other.G);
+	}
+};
+
+/**
+ * Function: octileCost()
+ *
+ * @return float The cost of the cheapest obstacle-free route between two tiles
+ */
+static float octileCost(int from_x, int from_y, int to_x, int to_y)
+{
+	int dx = abs(to_x - from_x), dy = abs(to_y - from_y);
+	return SUBGOAL_DIAG_COST*min(dx, dy) + (float)(max(dx, dy) - min(dx, dy));
+}
+
+/**
+ * Function: writeWords(), readWords()
+ * Use: Write/read 32-bit values little-endian, regardless of the host
+ */
+static void writeWords(ofstream &out_file, const uint32_t *words, size_t num_words)
+{
+	vector<char> bytes(num_words*4);
+	for(size_t word_idx = 0; word_idx < num_words; ++word_idx)
+		for(unsigned int byte_idx = 0; byte_idx < 4; ++byte_idx)
+			bytes[word_idx*4 + byte_idx] = (char)((words[word_idx] >> (8*byte_idx)) & 0xFF);
+	if(num_words > 0)
+		out_file.write(&bytes[0], bytes.size());
+}
+static bool readWords(ifstream &in_file, uint32_t *words, size_t num_words)
+{
+	vector<unsigned char> bytes(num_words*4);
+	if(num_words > 0 && !in_file.read((char *)&bytes[0], bytes.size()))
+		return false;
+	for(size_t word_idx = 0; word_idx < num_words; ++word_idx)
+	{
+		words[word_idx] = 0;
+		for(unsigned int byte_idx = 0; byte_idx < 4; ++byte_idx)
+			words[word_idx] |= (uint32_t)bytes[word_idx*4 + byte_idx] << (8*byte_idx);
+	}
+	return true;
+}
+
+// Generic constructor
+SubgoalGraph::SubgoalGraph()
+: game_map_ptr(NULL), map_width(0), map_height(0), map_checksum(0), query_stamp(0), path_cost(0.0f)
+{
+
+}
+
+// Destructor
+SubgoalGraph::~SubgoalGraph()
+{
+
+}
+
+// Preprocess a map
+void SubgoalGraph::build(const GameMap &game_map)
+{
+	game_map_ptr = &game_map;
+	map_width = game_map.getWidth();
+	map_height = game_map.getHeight();
+	map_checksum = calcChecksum(game_map);
+
+	// Subgoals: free tiles diagonal to an obstacle corner that sticks out
+	// (the obstacle is diagonal, and both tiles beside it are free)
+	subgoal_tiles.clear();
+	subgoal_bits.assign(((size_t)map_width*map_height + 63)/64, 0);
+	for(unsigned int row_idx = 0; row_idx < map_height; ++row_idx)
+	{
+		for(unsigned int col_idx = 0; col_idx < map_width; ++col_idx)
+		{
+			if(!game_map.getTraversable(col_idx, row_idx))
+				continue;
+			for(unsigned int dir_idx = 0; dir_idx < 4; ++dir_idx)
+			{
+				int corner_x = (int)col_idx + DIAG_DX[dir_idx];
+				int corner_y = (int)row_idx + DIAG_DY[dir_idx];
+				if(corner_x < 0 || (unsigned int)corner_x >= map_width ||
+				   corner_y < 0 || (unsigned int)corner_y >= map_height)
+					continue;
+				if(!game_map.getTraversable(corner_x, corner_y) &&
+				   game_map.getTraversable(corner_x, row_idx) && game_map.getTraversable(col_idx, corner_y))
+				{
+					uint32_t tile = row_idx*map_width + col_idx;
+					subgoal_tiles.push_back(tile);
+					subgoal_bits[tile/64] |= (uint64_t)1 << (tile%64);
+					break;
+				}
+			}
+		}
+	}
+	uint32_t num_nodes = subgoal_tiles.size();
+
+	// Join directly reachable pairs (the scans are independent, so split them across threads)
+	vector< vector< pair<uint32_t, float> > > reachable(num_nodes);
+	parallelFor(num_nodes, [&](unsigned int node_begin, unsigned int node_end)
+	{
+		for(unsigned int node = node_begin; node < node_end; ++node)
+			findReachable(subgoal_tiles[node], NO_NODE, reachable[node]);
+	});
+
+	// The scans aren't quite symmetric, so add both directions and keep one edge per pair
+	vector< vector<SubgoalEdge> > adjacency(num_nodes);
+	for(uint32_t node = 0; node < num_nodes; ++node)
+	{
+		for(unsigned int found_idx = 0; found_idx < reachable[node].size(); ++found_idx)
+		{
+			uint32_t target = findNode(reachable[node][found_idx].first);
+			SubgoalEdge edge = { target, reachable[node][found_idx].second };
+			adjacency[node].push_back(edge);
+			edge.target = node;
+			adjacency[target].push_back(edge);
+		}
+		vector< pair<uint32_t, float> >().swap(reachable[node]);
+	}
+	for(uint32_t node = 0; node < num_nodes; ++node)
+	{
+		vector<SubgoalEdge> &edges = adjacency[node];
+		sort(edges.begin(), edges.end(), [](const SubgoalEdge &a, const SubgoalEdge &b)
+		{
+			return (a.target != b.target) ? (a.target < b.target) : (a.cost < b.cost);
+		});
+		edges.erase(unique(edges.begin(), edges.end(), [](const SubgoalEdge &a, const SubgoalEdge &b)
+		{
+			return a.target == b.target;
+		}), edges.end());
+	}
+
+	buildRows(adjacency);
+}
+
+// Write the side file
+bool SubgoalGraph::save(const string &file_name) const
+{
+	ofstream out_file(file_name.c_str(), ios::out | ios::binary);
+	if(!out_file.is_open())
+		return false;
+
+	// Header (all little-endian uint32): magic, version, width, height, checksum low/high,
+	// number of nodes, number of edges
+	uint32_t header[8] = { SUBGOAL_MAGIC, SUBGOAL_VERSION, map_width, map_height,
+	                       (uint32_t)(map_checksum & 0xFFFFFFFFu), (uint32_t)(map_checksum >> 32),
+	                       (uint32_t)subgoal_tiles.size(), (uint32_t)edge_targets.size() };
+	writeWords(out_file, header, 8);
+
+	// Subgoal tiles, then the compressed edge rows (costs as IEEE float bits)
+	vector<uint32_t> cost_bits(edge_costs.size());
+	if(!edge_costs.empty())
+		memcpy(&cost_bits[0], &edge_costs[0], cost_bits.size()*4);
+	writeWords(out_file, subgoal_tiles.data(), subgoal_tiles.size());
+	writeWords(out_file, edge_offsets.data(), edge_offsets.size());
+	writeWords(out_file, edge_targets.data(), edge_targets.size());
+	writeWords(out_file, cost_bits.data(), cost_bits.size());
+
+	return out_file.good();
+}
+
+// Read the side file
+bool SubgoalGraph::load(const string &file_name, const GameMap &game_map)
+{
+	ifstream in_file(file_name.c_str(), ios::in | ios::binary);
+	if(!in_file.is_open())
+		return false;
+
+	uint32_t header[8];
+	if(!readWords(in_file, header, 8) || header[0] != SUBGOAL_MAGIC || header[1] != SUBGOAL_VERSION)
+	{
+		cout << "Not a subgoal graph (or unsupported version): " << file_name << endl;
+		return false;
+	}
+	uint64_t file_checksum = (uint64_t)header[4] | ((uint64_t)header[5] << 32);
+	if(header[2] != game_map.getWidth() || header[3] != game_map.getHeight() ||
+	   file_checksum != calcChecksum(game_map))
+	{
+		cout << "Subgoal graph was built for a different map: " << file_name << endl;
+		return false;
+	}
+
+	uint32_t num_nodes = header[6], num_edges = header[7];
+	vector<uint32_t> new_tiles(num_nodes), new_offsets(num_nodes + 1), new_targets(num_edges), cost_bits(num_edges);
+	if(!readWords(in_file, new_tiles.data(), num_nodes) ||
+	   !readWords(in_file, new_offsets.data(), num_nodes + 1) ||
+	   !readWords(in_file, new_targets.data(), num_edges) ||
+	   !readWords(in_file, cost_bits.data(), num_edges))
+	{
+		cout << "Truncated subgoal graph: " << file_name << endl;
+		return false;
+	}
+
+	game_map_ptr = &game_map;
+	map_width = header[2];
+	map_height = header[3];
+	map_checksum = file_checksum;
+	subgoal_tiles.swap(new_tiles);
+	edge_offsets.swap(new_offsets);
+	edge_targets.swap(new_targets);
+	edge_costs.resize(num_edges);
+	if(num_edges > 0)
+		memcpy(&edge_costs[0], &cost_bits[0], num_edges*4);
+
+	subgoal_bits.assign(((size_t)map_width*map_height + 63)/64, 0);
+	for(uint32_t node = 0; node < num_nodes; ++node)
+		subgoal_bits[subgoal_tiles[node]/64] |= (uint64_t)1 << (subgoal_tiles[node]%64);
+
+	SearchLabel empty_label = { 0.0f, NO_NODE, 0 };
+	fwd_labels.assign(num_nodes + 2, empty_label);
+	bwd_labels.assign(num_nodes + 2, empty_label);
+	query_stamp = 0;
+	return true;
+}
+
+// Load the side file, or build and save it
+bool SubgoalGraph::loadOrBuild(const string &file_name, const GameMap &game_map)
+{
+	if(load(file_name, game_map))
+		return true;
+
+	build(game_map);
+	if(!save(file_name))
+		cout << "Failed to write subgoal graph: " << file_name << endl;
+	return false;
+}
+
+// Find a path
+bool SubgoalGraph::findPath(const PosTile &start, const PosTile &goal, vector<PosTile> &path)
+{
+	path.clear();
+	path_cost = 0.0f;
+	if(game_map_ptr == NULL ||
+	   start.x >= map_width || start.y >= map_height || goal.x >= map_width || goal.y >= map_height ||
+	   !game_map_ptr->getTraversable(start.x, start.y) || !game_map_ptr->getTraversable(goal.x, goal.y))
+		return false;
+	if(start.x == goal.x && start.y == goal.y)
+	{
+		path.push_back(start);
+		return true;
+	}
+
+	// Link the start and goal into the graph as two extra nodes
+	uint32_t num_nodes = subgoal_tiles.size();
+	uint32_t start_node = num_nodes, goal_node = num_nodes + 1;
+	uint32_t start_tile = start.y*map_width + start.x;
+	uint32_t goal_tile = goal.y*map_width + goal.x;
+	vector< pair<uint32_t, float> > start_links, goal_links;
+	linkEndpoint(start_tile, goal_tile, goal_node, start_links);
+	linkEndpoint(goal_tile, start_tile, start_node, goal_links);
+
+	// New stamp for this query (on wrap-around, wipe the old stamps)
+	if(++query_stamp == 0)
+	{
+		for(size_t node = 0; node < fwd_labels.size(); ++node)
+			fwd_labels[node].stamp = bwd_labels[node].stamp = 0;
+		query_stamp = 1;
+	}
+
+	// Search the graph, then list the nodes from start to goal
+	if(!searchFlat(start_links, goal_links, goal))
+		return false;
+	path_cost = fwd_labels[goal_node].dist;
+
+	vector<uint32_t> nodes;
+	for(uint32_t node = goal_node; node != NO_NODE; node = fwd_labels[node].parent)
+		nodes.push_back(node);
+	reverse(nodes.begin(), nodes.end());
+
+	// Then the nodes into tiles
+	path.push_back(start);
+	for(unsigned int node_idx = 1; node_idx < nodes.size(); ++node_idx)
+	{
+		uint32_t from_node = nodes[node_idx - 1], to_node = nodes[node_idx];
+		uint32_t from_tile = (from_node == start_node) ? start_tile : subgoal_tiles[from_node];
+		uint32_t to_tile = (to_node == goal_node) ? goal_tile : subgoal_tiles[to_node];
+		if(!appendSegment(from_tile, to_tile, path))
+		{
+			path.clear();
+			return false;
+		}
+	}
+	return true;
+}
+
+// Check one move
+bool SubgoalGraph::canMove(int x, int y, int dx, int dy) const
+{
+	int new_x = x + dx, new_y = y + dy;
+	if(new_x < 0 || (unsigned int)new_x >= map_width || new_y < 0 || (unsigned int)new_y >= map_height ||
+	   !game_map_ptr->getTraversable(new_x, new_y))
+		return false;
+
+	// Diagonal moves may not cut an obstacle corner
+	if(dx != 0 && dy != 0)
+		return game_map_ptr->getTraversable(new_x, y) && game_map_ptr->getTraversable(x, new_y);
+	return true;
+}
+
+// Find the node of a subgoal tile
+uint32_t SubgoalGraph::findNode(uint32_t tile) const
+{
+	if(!isSubgoal(tile))
+		return NO_NODE;
+	return lower_bound(subgoal_tiles.begin(), subgoal_tiles.end(), tile) - subgoal_tiles.begin();
+}
+
+// Hash the map (FNV-1a over the size and one bit per tile)
+uint64_t SubgoalGraph::calcChecksum(const GameMap &game_map)
+{
+	uint64_t hash = 0xCBF29CE484222325ULL;
+	uint64_t header[2] = { game_map.getWidth(), game_map.getHeight() };
+	for(unsigned int field_idx = 0; field_idx < 2; ++field_idx)
+		hash = (hash ^ header[field_idx]) * 0x100000001B3ULL;
+
+	// One step per traversability word (64 tiles)
+	for(unsigned int row_idx = 0; row_idx < game_map.getHeight(); ++row_idx)
+	{
+		const uint64_t *row = game_map.getTraversableRow(row_idx);
+		for(unsigned int word_idx = 0; word_idx < game_map.getRowWords(); ++word_idx)
+			hash = (hash ^ row[word_idx]) * 0x100000001B3ULL;
+	}
+	return hash;
+}
+
+// Scan in one direction
+unsigned int SubgoalGraph::scanClearance(int x, int y, int dx, int dy, uint32_t extra_target, bool &hit_target) const
+{
+	unsigned int num_moves = 0;
+	hit_target = false;
+	while(canMove(x, y, dx, dy))
+	{
+		x += dx;
+		y += dy;
+		uint32_t tile = y*map_width + x;
+		if(isSubgoal(tile) || tile == extra_target)
+		{
+			hit_target = true;
+			return num_moves;
+		}
+		++num_moves;
+	}
+	return num_moves;
+}
+
+// Find the directly reachable subgoals
+void SubgoalGraph::findReachable(uint32_t tile, uint32_t extra_target, vector< pair<uint32_t, float> > &found) const
+{
+	found.clear();
+	int x = tile % map_width, y = tile / map_width;
+	bool hit_target;
+
+	// Straight lines
+	for(unsigned int dir_idx = 0; dir_idx < 4; ++dir_idx)
+	{
+		int dx = STRAIGHT_DX[dir_idx], dy = STRAIGHT_DY[dir_idx];
+		int num_moves = scanClearance(x, y, dx, dy, extra_target, hit_target) + 1;
+		if(hit_target)
+			found.push_back(make_pair((y + num_moves*dy)*map_width + (x + num_moves*dx), (float)num_moves));
+	}
+
+	// Each diagonal sweeps its quadrant: step along the diagonal, and scan straight out from
+	// every step. A straight scan can't reach further than the one before it (or it would
+	// pass a subgoal that is closer), which is what makes the found subgoals "direct"
+	for(unsigned int dir_idx = 0; dir_idx < 4; ++dir_idx)
+	{
+		int dx = DIAG_DX[dir_idx], dy = DIAG_DY[dir_idx];
+		bool unused_hit;
+		int max_horiz = scanClearance(x, y, dx, 0, extra_target, unused_hit);
+		int max_vert = scanClearance(x, y, 0, dy, extra_target, unused_hit);
+		int num_diag = scanClearance(x, y, dx, dy, extra_target, hit_target);
+		if(hit_target)
+			found.push_back(make_pair((y + (num_diag + 1)*dy)*map_width + (x + (num_diag + 1)*dx),
+			                          SUBGOAL_DIAG_COST*(num_diag + 1)));
+
+		for(int diag_idx = 1; diag_idx <= num_diag; ++diag_idx)
+		{
+			int row_x = x + diag_idx*dx, row_y = y + diag_idx*dy;
+			float diag_cost = SUBGOAL_DIAG_COST*diag_idx;
+
+			int num_moves = scanClearance(row_x, row_y, dx, 0, extra_target, hit_target);
+			if(num_moves <= max_horiz && hit_target)
+			{
+				found.push_back(make_pair(row_y*map_width + (row_x + (num_moves + 1)*dx), diag_cost + num_moves + 1));
+				--num_moves;
+			}
+			max_horiz = min(max_horiz, num_moves);
+
+			num_moves = scanClearance(row_x, row_y, 0, dy, extra_target, hit_target);
+			if(num_moves <= max_vert && hit_target)
+			{
+				found.push_back(make_pair((row_y + (num_moves + 1)*dy)*map_width + row_x, diag_cost + num_moves + 1));
+				--num_moves;
+			}
+			max_vert = min(max_vert, num_moves);
+		}
+	}
+}
+
+// Pack the edge lists
+void SubgoalGraph::buildRows(const vector< vector<SubgoalEdge> > &adjacency)
+{
+	uint32_t num_nodes = adjacency.size();
+	edge_offsets.assign(num_nodes + 1, 0);
+	edge_targets.clear();
+	edge_costs.clear();
+	for(uint32_t node = 0; node < num_nodes; ++node)
+	{
+		for(unsigned int edge_idx = 0; edge_idx < adjacency[node].size(); ++edge_idx)
+		{
+			edge_targets.push_back(adjacency[node][edge_idx].target);
+			edge_costs.push_back(adjacency[node][edge_idx].cost);
+		}
+		edge_offsets[node + 1] = edge_targets.size();
+	}
+
+	SearchLabel empty_label = { 0.0f, NO_NODE, 0 };
+	fwd_labels.assign(num_nodes + 2, empty_label);
+	bwd_labels.assign(num_nodes + 2, empty_label);
+	query_stamp = 0;
+}
+
+// Link a query start/goal to the graph
+void SubgoalGraph::linkEndpoint(uint32_t tile, uint32_t other_tile, uint32_t other_node,
+                                vector< pair<uint32_t, float> > &links) const
+{
+	links.clear();
+	uint32_t node = findNode(tile);
+	if(node != NO_NODE)
+	{
+		links.push_back(make_pair(node, 0.0f));
+		return;
+	}
+
+	vector< pair<uint32_t, float> > found;
+	findReachable(tile, other_tile, found);
+	for(unsigned int found_idx = 0; found_idx < found.size(); ++found_idx)
+	{
+		uint32_t found_node = (found[found_idx].first == other_tile) ? other_node : findNode(found[found_idx].first);
+		links.push_back(make_pair(found_node, found[found_idx].second));
+	}
+}
+
+// A* over the full graph
+bool SubgoalGraph::searchFlat(const vector< pair<uint32_t, float> > &start_links,
+                              const vector< pair<uint32_t, float> > &goal_links, const PosTile &goal)
+{
+	MemScope mem_scope(MemSubsystem::MEM_SEARCH);
+	uint32_t num_nodes = subgoal_tiles.size();
+	uint32_t start_node = num_nodes, goal_node = num_nodes + 1;
+
+	// The goal's links are kept in the backward labels, so expanding a node can check them
+	for(unsigned int link_idx = 0; link_idx < goal_links.size(); ++link_idx)
+	{
+		SearchLabel goal_label = { goal_links[link_idx].second, goal_node, query_stamp };
+		bwd_labels[goal_links[link_idx].first] = goal_label;
+	}
+
+	SearchLabel start_label = { 0.0f, NO_NODE, query_stamp };
+	fwd_labels[start_node] = start_label;
+	priority_queue<FlatEntry> open_list;
+	FlatEntry start_entry = { 0, 0.0f, start_node };
+	open_list.push(start_entry);
+	size_t max_open_size = 0;
+
+	while(!open_list.empty())
+	{
+		max_open_size = max(max_open_size, open_list.size());
+		FlatEntry cur_entry = open_list.top();
+		open_list.pop();
+		uint32_t cur_node = cur_entry.node;
+		if(cur_node == goal_node)
+		{
+			memRecordOpenList("SubgoalGraph", max_open_size, sizeof(FlatEntry));
+			return true;
+		}
+
+		// Skip stale entries (a cheaper route was found after this one was pushed)
+		float cur_G = fwd_labels[cur_node].dist;
+		if(cur_entry.G > cur_G + COST_EPSILON)
+			continue;
+
+		// Relax the start's links, or the node's graph edges, plus its goal link (if any)
+		auto relax = [&](uint32_t new_node, float edge_cost)
+		{
+			float new_G = cur_G + edge_cost;
+			if(new_node == start_node ||
+			   (fwd_labels[new_node].stamp == query_stamp && fwd_labels[new_node].dist <= new_G))
+				return;
+
+			SearchLabel new_label = { new_G, cur_node, query_stamp };
+			fwd_labels[new_node] = new_label;
+			uint32_t new_tile = (new_node == goal_node) ? goal.y*map_width + goal.x : subgoal_tiles[new_node];
+			float new_H = octileCost(new_tile % map_width, new_tile / map_width, goal.x, goal.y);
+			FlatEntry new_entry = { (uint32_t)lroundf((new_G + new_H)*COST_UNITS), new_G, new_node };
+			open_list.push(new_entry);
+		};
+		if(cur_node == start_node)
+		{
+			for(unsigned int link_idx = 0; link_idx < start_links.size(); ++link_idx)
+				relax(start_links[link_idx].first, start_links[link_idx].second);
+		}
+		else
+		{
+			for(uint32_t edge_idx = edge_offsets[cur_node]; edge_idx < edge_offsets[cur_node + 1]; ++edge_idx)
+				relax(edge_targets[edge_idx], edge_costs[edge_idx]);
+		}
+		if(bwd_labels[cur_node].stamp == query_stamp)
+			relax(goal_node, bwd_labels[cur_node].dist);
+	}
+
+	memRecordOpenList("SubgoalGraph", max_open_size, sizeof(FlatEntry));
+	return false;
+}
+
+// Expand a direct edge into tiles
+bool SubgoalGraph::appendSegment(uint32_t from_tile, uint32_t to_tile, vector<PosTile> &path) const
+{
+	int from_x = from_tile % map_width, from_y = from_tile / map_width;
+	int to_x = to_tile % map_width, to_y = to_tile / map_width;
+	int step_x = (to_x > from_x) - (to_x < from_x);
+	int step_y = (to_y > from_y) - (to_y < from_y);
+	int num_diag = min(abs(to_x - from_x), abs(to_y - from_y));
+	int num_straight = max(abs(to_x - from_x), abs(to_y - from_y)) - num_diag;
+	int straight_x = (abs(to_x - from_x) > abs(to_y - from_y)) ? step_x : 0;
+	int straight_y = (straight_x == 0) ? step_y : 0;
+
+	// The edge was found by a scan from one end (diagonal steps first, then straight),
+	// so walking diagonal-first or straight-first from this end is clear
+	for(unsigned int order_idx = 0; order_idx < 2; ++order_idx)
+	{
+		size_t old_size = path.size();
+		int x = from_x, y = from_y;
+		bool clear = true;
+		for(int move_idx = 0; move_idx < num_diag + num_straight && clear; ++move_idx)
+		{
+			bool diag_move = (order_idx == 0) ? (move_idx < num_diag) : (move_idx >= num_straight);
+			int dx = diag_move ? step_x : straight_x;
+			int dy = diag_move ? step_y : straight_y;
+			clear = canMove(x, y, dx, dy);
+			x += dx;
+			y += dy;
+			PosTile tile = { (unsigned int)x, (unsigned int)y };
+			path.push_back(tile);
+		}
+		if(clear)
+			return true;
+		path.resize(old_size);
+	}
+	return false;
+}
@@ -0,0 +1,44 @@
+/**
+ * VersionedMap.cpp
+ *  Created on: Oct 18, 2026
+ *      Author: iRobot maintainers
+ *     Purpose: Publishes immutable, versioned GameMap snapshots
+ */
+#include "../headers/VersionedMap.hpp"
+
+using namespace std;
+
+// Initialization constructor
+VersionedMap::VersionedMap(const GameMap &initial_map)
+: current(make_shared<const GameMap>(initial_map))
+{
+
+}
+
+// Destructor
+VersionedMap::~VersionedMap()
+{
+
+}
+
+// Publish an obstacle update
+shared_ptr<const GameMap> VersionedMap::updateObstacles(const vector<PosTile> &tiles, bool traversable)
+{
+	lock_guard<mutex> writer_lock(writer_mutex);
+
+	// The copy shares every page; the update replaces only the pages it changes,
+	// so readers of the old version are unaffected
+	shared_ptr<GameMap> next_map = make_shared<GameMap>(*atomic_load(&current));
+	next_map->updateObstacles(tiles, traversable);
+
+	shared_ptr<const GameMap> published = next_map;
+	atomic_store(&current, published);
+	return published;
+}
+
+// Publish a whole map
+void VersionedMap::publish(const GameMap &new_map)
+{
+	lock_guard<mutex> writer_lock(writer_mutex);
+	atomic_store(&current, shared_ptr<const GameMap>(make_shared<const GameMap>(new_map)));
+}
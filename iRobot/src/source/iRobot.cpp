@@ -14,145 +14,241 @@
 // Include the modules for pathfinding
 #include "../headers/GameMap.hpp"
 #include "../headers/AStar.hpp"
+#include "../headers/PathWriter.hpp"
+#include "../headers/MapGenerator.hpp"
+#include "../headers/Benchmark.hpp"
+#include "../headers/SubgoalGraph.hpp"
+#include "../headers/FringeSearch.hpp"
+#include "../headers/MemProfile.hpp"
 
 
 using namespace std;
 
+/**
+ * Function: runGenerator()
+ * Use: Generator mode: iRobot gen <topology> <size> <seed> <out_name> [density] [num_queries] [runs]
+ *      Writes '<out_name>.dat' (JSON), '<out_name>.bin' (binary map) and
+ *      '<out_name>_queries.txt' (query set) for a <size> x <size> map
+ *      With runs '1', the JSON holds [x,y,length] runs instead of single tiles
+ *
+ * @param argc Number of command line arguments
+ * @param argv The command line arguments
+ * @return 0 maps written
+ *         1 bad arguments or write failure
+ */
+static int runGenerator(int argc, char *argv[])
+{
+	MapTopology::Type topology;
+	if(argc < 6 || !MapGenerator::parseTopology(argv[2], topology))
+	{
+		cout << "Usage: " << argv[0] << " gen <random|maze|rooms|warehouse> <size> <seed> <out_name>"
+		     << " [density (default 0.3)] [num_queries (default 100)] [runs (default 0)]" << endl;
+		return 1;
+	}
+	unsigned int map_size = strtoul(argv[3], NULL, 10);
+	unsigned long long seed = strtoull(argv[4], NULL, 10);
+	string out_name = argv[5];
+	double density = (argc > 6) ? atof(argv[6]) : 0.3;
+	unsigned int num_queries = (argc > 7) ? strtoul(argv[7], NULL, 10) : 100;
+	bool use_runs = (argc > 8) && (atoi(argv[8]) != 0);
+
+	cout << "Generating " << argv[2] << " map (" << map_size << "," << map_size << "), seed " << seed << endl;
+	MapGenerator generator(map_size, map_size, seed);
+	generator.generate(topology, density);
+
+	vector<PathQueryPair> queries;
+	generator.generateQueries(max(num_queries, 1u), queries);
+	if(queries.empty())
+	{
+		cout << "No traversable tiles for queries" << endl;
+		return 1;
+	}
+
+	// The first query doubles as robotStart/robotEnd of the map files
+	if(!generator.writeJson(out_name + ".dat", queries[0], use_runs) ||
+	   !generator.writeBinary(out_name + ".bin", queries[0]) ||
+	   !MapGenerator::writeQueries(out_name + "_queries.txt", queries))
+	{
+		cout << "Failed to write output for: " << out_name << endl;
+		return 1;
+	}
+
+	cout << "Wrote " << out_name << ".dat, " << out_name << ".bin, " << out_name << "_queries.txt" << endl;
+	return 0;
+}
+
 /**
  * Function: main()
- * Use: Prompts user for input file number (1-6)
+ * Use: Prompts user for input file number (1-6), or a '.dat'/'.bin' file name
  *      Loads obstacles, start, end data
  *      Creates map of sufficience size
  *      Uses A* to find shortest path from start to end
+ *      if(PATH_ENGINE_SUBGOAL), tries the preprocessed subgoal graph first
+ *      if(PATH_ENGINE_FRINGE), uses the low-memory FringeSearch instead of A*
+ *      if(PATH_ENGINE_GOAL_BOUNDS), prunes A*'s moves with the map's goal bounds
+ *      if(MEM_PROFILE), measures the load/search/output phases (report printed at exit)
+ *      'iRobot gen ...' runs the map generator instead (see runGenerator())
+ *      'iRobot bench ...' runs a benchmark instead (see runBenchmark())
  *
- * @param void
+ * @param argc Number of command line arguments
+ * @param argv The command line arguments
  * @return 0 found path from start to end
  *         1 no path from start to end
  */
 
-int main() {
+int main(int argc, char *argv[]) {
+
+	// Generator and benchmark modes
+	if(argc > 1 && string(argv[1]) == "gen")
+		return runGenerator(argc, argv);
+	if(argc > 1 && string(argv[1]) == "bench")
+		return runBenchmark(argc, argv);
 
 	// Ask for the input file name
 	string datInputLine;
 	stringstream datFileName;
-	cout << "Please enter input file number (1-6) ('ENTER' for default (1)): ";
+	cout << "Please enter input file number (1-6) or file name ('ENTER' for default (1)): ";
 	getline(cin, datInputLine);
 	if(datInputLine == "")
 		datInputLine = "1";
-	datFileName << "set" << datInputLine << ".dat";
 
-
-	// Try to load the .dat file
-	ifstream datFile;
-	string datString;
-	datFile.open(datFileName.str().c_str());
-	if(datFile.is_open())
+	// Output goes to '<base>_out.txt', where <base> is 'set#' or the file name without extension
+	string outBaseName;
+	size_t extension_pos = datInputLine.rfind('.');
+	if(extension_pos == string::npos)
 	{
-		// All data provided as samples is formatted as a single line
-		// If other dat files contain multiple lines, the JSON parse below will not work
-		getline(datFile,datString);
+		datFileName << "set" << datInputLine << ".dat";
+		outBaseName = "set" + datInputLine;
 	}
 	else
 	{
-		cout << "Failed to open file: " << datFileName << endl;
-		return 1;
+		datFileName << datInputLine;
+		outBaseName = datInputLine.substr(0, extension_pos);
 	}
 
-
-	// Parse the .dat string
-	Json::Value root;
-	Json::Reader reader;
-	bool parsedSuccess = reader.parse(datString, root, false);
-	if(!parsedSuccess)
-	{
-		// Report failures and their locations in the document.
-		cout << "Failed to parse JSON" << endl
-			 <<	reader.getFormatedErrorMessages()
-			 << endl;
+	// Load the map, and the start and end points
+	GameMap m_game_map;
+	PosTile robot_start, robot_end;
+	MemPhase load_phase("load");
+	if(!m_game_map.loadFile(datFileName.str(), robot_start, robot_end))
 		return 1;
-	}
+	load_phase.end();
 
-	// Find the max_x and max_y within the obstacles
-	Json::Value obstacles = root["obstacles"];
-	unsigned int obstacles_size = obstacles.size();
-	unsigned int max_obs_x = 0, max_obs_y = 0;
-	for(unsigned int obs_idx = 0; obs_idx < obstacles_size; ++obs_idx)
+	bool blocked = false, done = false;
+	vector<PosTile> a_star_path;
+	MemPhase search_phase("search");
+
+#if PATH_ENGINE_SUBGOAL
+	// Answer from the subgoal graph if it can (it forbids corner cutting, so its path can be much
+	// longer than A*'s on maze-like maps; A* only runs if the graph finds no path)
+	SubgoalGraph subgoal_graph;
+	subgoal_graph.loadOrBuild(SubgoalGraph::getSideFileName(datFileName.str()), m_game_map);
+	done = subgoal_graph.findPath(robot_start, robot_end, a_star_path);
+	if(done)
+		cout << "Subgoal graph path (no corner cutting, so it may be longer than A*'s), cost "
+		     << subgoal_graph.getPathCost() << endl;
+#endif
+
+#if PATH_ENGINE_FRINGE
+	if(!done)
 	{
-		unsigned int cur_x = obstacles[obs_idx][(unsigned int)0].asUInt();
-		unsigned int cur_y = obstacles[obs_idx][(unsigned int)1].asUInt();
+		// Search with the low-memory engine (it stops, rather than going over FRINGE_MAX_KB)
+		FringeSearch fringe_search(m_game_map, robot_start, robot_end);
+		SearchStatus::Type status = SearchStatus::SEARCH_RUNNING;
+		while(status == SearchStatus::SEARCH_RUNNING)
+			status = fringe_search.advance(10000);
+		cout << "Fringe search: " << fringe_search.getIterationNum() << " tiles expanded, "
+		     << fringe_search.getPeakBytes() / 1024 << " kB peak" << endl;
+		if(status == SearchStatus::SEARCH_MEMORY_LIMIT)
+			cout << "Fringe search stopped at its memory cap (" << FRINGE_MAX_KB << " kB), falling back to A*" << endl;
 
-		if(cur_x > max_obs_x) max_obs_x = cur_x;
-		if(cur_y > max_obs_y) max_obs_y = cur_y;
+		// Only an exhausted search proves there is no path; at the memory cap A* gets a try
+		blocked = (status == SearchStatus::SEARCH_UNREACHABLE);
+		done    = (status == SearchStatus::SEARCH_FOUND);
+		if(done)
+			fringe_search.getPath(a_star_path);
 	}
-	cout << "Max x/y = (" << max_obs_x << "," << max_obs_y << ")" << endl;
-
-	// Now that the data is loaded, build a GameMap
-#if DEBUG
-	// Use a size of (20,20) for readability in debugging
-	GameMap m_game_map = GameMap(obstacles, 20, 20);
-	m_game_map.printMap();
-#else
-	// We'll use a default (1500,1500) because of supplied input data parameters
-	GameMap m_game_map = GameMap(obstacles, 1500, 1500);
 #endif
 
-	// Load the start and end points
-	Json::Value robot_start_dat = root["robotStart"];
-	Json::Value robot_end_dat   = root["robotEnd"];
-#if DEBUG
-	posTile robot_start = {1, 1};
-	posTile robot_end = {19, 19};
-#else
-	PosTile robot_start = {robot_start_dat[(unsigned int)0].asUInt(),
-			                robot_start_dat[(unsigned int)1].asUInt()};
-	PosTile robot_end = {robot_end_dat[(unsigned int)0].asUInt(),
-			              robot_end_dat[(unsigned int)1].asUInt()};
+#if PATH_ENGINE_GOAL_BOUNDS
+	// Goal bounds for A* (kept out here, since the search only points at them)
+	GoalBounds goal_bounds;
+	if(!done && !blocked)
+		goal_bounds.loadOrBuild(GoalBounds::getSideFileName(datFileName.str()), m_game_map);
 #endif
 
-	// Prepare A* by building a F/G/H map and pushing the start point onto the Open list
-	AStar m_star_map = AStar(m_game_map, robot_start, robot_end);
-//	m_star_map.initOpenList();
-
-	// Run A* until it sets 'done' or 'blocked' to true
-	string inputLine;
-	cout << "Hit <Enter> to run A*";
-	getline(cin, inputLine);
-	bool blocked = false, done = false;
-	while(!blocked && !done)
+	if(!done && !blocked)
 	{
-		// Run A* for 1 step
-		m_star_map.runStep(m_game_map, blocked, done);
+		// Prepare A* by building a F/G/H map and pushing the start point onto the Open list
+		AStar m_star_map = AStar(m_game_map, robot_start, robot_end);
+#if PATH_ENGINE_GOAL_BOUNDS
+		m_star_map.setGoalBounds(&goal_bounds);
+#endif
+//		m_star_map.initOpenList();
+
+		// Run A* until it finds the path or exhausts the map
+		string inputLine;
+		cout << "Hit <Enter> to run A*";
+		getline(cin, inputLine);
+		SearchStatus::Type status = SearchStatus::SEARCH_RUNNING;
+		while(status == SearchStatus::SEARCH_RUNNING)
+		{
+			// Run A* for a batch of steps (notify, so it doesn't look like it's stalled)
+			m_star_map.printProgress();
+			status = m_star_map.advance(10000);
+		}
+		blocked = (status == SearchStatus::SEARCH_UNREACHABLE);
+		done    = (status == SearchStatus::SEARCH_FOUND);
+		if(done)
+			m_star_map.getPath(a_star_path);
 	}
 
+	search_phase.end();
+
 	// A* has finished, open a file to write results
+	MemPhase output_phase("output");
+	MemScope output_scope(MemSubsystem::MEM_OUTPUT);
 	ofstream outputFile;
 	stringstream outFileName;
-	outFileName << "set" << datInputLine << "_out.txt";
+#if PATH_OUT_BINARY
+	outFileName << outBaseName << "_out.bin";
+	outputFile.open(outFileName.str().c_str(), ios::out | ios::binary);
+#else
+	outFileName << outBaseName << "_out.txt";
 	outputFile.open(outFileName.str().c_str());
+#endif
+
+	// Format everything into one buffer, so the file is written in a single call
+	PathWriter path_writer(64*1024);
 
+#if !PATH_OUT_BINARY
 	// Add input filename to beginning of output file
 	//     (comment this out if pure path sequence is desired)
-	stringstream outputLine;
-	outputLine << "Path results for file: " << datFileName.str() << endl;
-	outputFile << outputLine.str();
+	path_writer.appendText("Path results for file: " + datFileName.str() + "\n");
 
 	// If the path is blocked (no route from robot_start to robot_end), print an error
 	if(blocked)
 	{
-		outputFile << "There is no navigable path from (" << robot_start.x << "," << robot_start.y
+		stringstream outputLine;
+		outputLine << "There is no navigable path from (" << robot_start.x << "," << robot_start.y
 				   << ") to (" << robot_end.x << "," << robot_end.y << ")" << endl;
+		path_writer.appendText(outputLine.str());
 	}
+#endif
 
 	// If the path is done (found route from robot_start to robot_end), print the path
-	if(done)
+	// (a blocked binary result is an empty path)
+	if(done || PATH_OUT_BINARY)
 	{
-		stringstream path_string;
-		m_star_map.getPathString(path_string);
-		outputFile << path_string.str();
+		path_writer.appendPath(a_star_path,
+		                       PATH_OUT_BINARY ? PathFormat::FORMAT_BINARY : PathFormat::FORMAT_TEXT,
+		                       PATH_OUT_WAYPOINTS);
 	}
 
-	// Close the output file
+	// Write and close the output file
+	path_writer.writeTo(outputFile);
 	outputFile.close();
+	output_phase.end();
 
 	// Finish and exit
 	if(blocked)